@@ -0,0 +1,750 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef SFML_BENCH_FONT
+    #define SFML_BENCH_FONT "sansation.ttf"
+#endif
+
+
+////////////////////////////////////////////////////////////
+// Command line options
+////////////////////////////////////////////////////////////
+struct Options
+{
+    Options() :
+    width   (800),
+    height  (600),
+    warmup  (10),
+    frames  (100),
+    scale   (1.f),
+    software(false),
+    threads (1),
+    font    (SFML_BENCH_FONT),
+    filter  (),
+    output  ()
+    {
+    }
+
+    unsigned int width;    // Size of the render target
+    unsigned int height;
+    unsigned int warmup;   // Frames rendered before measuring
+    unsigned int frames;   // Frames measured
+    float        scale;    // Factor applied to the number of items of each workload
+    bool         software; // Render with sf::SoftwareRenderTarget instead of OpenGL
+    unsigned int threads;  // Threads of the software render target
+    std::string  font;     // Font used by the text workloads
+    std::string  filter;   // Only run the workloads whose name contains this string
+    std::string  output;   // File to write the results to, instead of the standard output
+};
+
+
+////////////////////////////////////////////////////////////
+// Base class for workloads
+////////////////////////////////////////////////////////////
+class Workload
+{
+public:
+
+    Workload(const std::string& name, std::size_t items) :
+    m_name (name),
+    m_items(items)
+    {
+    }
+
+    virtual ~Workload()
+    {
+    }
+
+    const std::string& getName() const
+    {
+        return m_name;
+    }
+
+    std::size_t getItems() const
+    {
+        return m_items;
+    }
+
+    // Prepare the resources, return a reason to skip the workload or an empty string
+    virtual std::string setup(const Options& options, bool software) = 0;
+
+    // Render a frame (the target is cleared before)
+    virtual void frame(sf::RenderTarget& target, unsigned int index) = 0;
+
+protected:
+
+    std::string m_name;
+    std::size_t m_items;
+};
+
+
+////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////
+namespace
+{
+    // Deterministic pseudo-random numbers, so that runs are comparable
+    unsigned int seed = 12345;
+    unsigned int randomInteger()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 8) & 0xFFFFFF;
+    }
+
+    float randomFloat(float max)
+    {
+        return max * randomInteger() / 0xFFFFFF;
+    }
+
+    sf::Color randomColor()
+    {
+        return sf::Color(128 + randomInteger() % 128, 128 + randomInteger() % 128, 128 + randomInteger() % 128);
+    }
+
+    // Create a texture with a recognizable pattern
+    bool createTexture(sf::Texture& texture, unsigned int size, unsigned int variant)
+    {
+        sf::Image image;
+        image.create(size, size);
+        for (unsigned int y = 0; y < size; ++y)
+            for (unsigned int x = 0; x < size; ++x)
+                image.setPixel(x, y, sf::Color((x * 255 / size + variant * 40) % 256, (y * 255 / size) % 256, ((x ^ y) + variant * 90) % 256));
+
+        return texture.loadFromImage(image);
+    }
+
+    std::size_t scaled(std::size_t count, const Options& options)
+    {
+        return std::max<std::size_t>(static_cast<std::size_t>(count * options.scale), 1);
+    }
+
+    // Escape a string for JSON
+    std::string quote(const std::string& string)
+    {
+        std::string result = "\"";
+        for (std::string::const_iterator it = string.begin(); it != string.end(); ++it)
+        {
+            if ((*it == '"') || (*it == '\\'))
+                result += '\\';
+            if (static_cast<unsigned char>(*it) >= 0x20)
+                result += *it;
+        }
+
+        return result + "\"";
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Many sprites sharing a single texture
+////////////////////////////////////////////////////////////
+class SpritesOneTexture : public Workload
+{
+public:
+
+    SpritesOneTexture(const Options& options) :
+    Workload("sprites_one_texture", scaled(10000, options))
+    {
+    }
+
+    std::string setup(const Options& options, bool)
+    {
+        if (!createTexture(m_texture, 64, 0))
+            return "failed to create the texture";
+
+        m_sprites.resize(m_items);
+        for (std::size_t i = 0; i < m_sprites.size(); ++i)
+        {
+            m_sprites[i].setTexture(m_texture);
+            m_sprites[i].setTextureRect(sf::IntRect(randomInteger() % 32, randomInteger() % 32, 32, 32));
+            m_sprites[i].setPosition(randomFloat(static_cast<float>(options.width)), randomFloat(static_cast<float>(options.height)));
+            m_sprites[i].setColor(randomColor());
+        }
+
+        return "";
+    }
+
+    void frame(sf::RenderTarget& target, unsigned int index)
+    {
+        for (std::size_t i = 0; i < m_sprites.size(); ++i)
+        {
+            m_sprites[i].setRotation(static_cast<float>((index + i) % 360));
+            target.draw(m_sprites[i]);
+        }
+    }
+
+private:
+
+    sf::Texture m_texture;
+    std::vector<sf::Sprite> m_sprites;
+};
+
+
+////////////////////////////////////////////////////////////
+// Many sprites alternating between several textures
+////////////////////////////////////////////////////////////
+class SpritesManyTextures : public Workload
+{
+public:
+
+    SpritesManyTextures(const Options& options) :
+    Workload("sprites_many_textures", scaled(10000, options))
+    {
+    }
+
+    std::string setup(const Options& options, bool)
+    {
+        for (unsigned int i = 0; i < TextureCount; ++i)
+        {
+            if (!createTexture(m_textures[i], 64, i))
+                return "failed to create the textures";
+        }
+
+        // Consecutive sprites use different textures, which is the worst case
+        m_sprites.resize(m_items);
+        for (std::size_t i = 0; i < m_sprites.size(); ++i)
+        {
+            m_sprites[i].setTexture(m_textures[i % TextureCount]);
+            m_sprites[i].setTextureRect(sf::IntRect(0, 0, 32, 32));
+            m_sprites[i].setPosition(randomFloat(static_cast<float>(options.width)), randomFloat(static_cast<float>(options.height)));
+        }
+
+        return "";
+    }
+
+    void frame(sf::RenderTarget& target, unsigned int index)
+    {
+        for (std::size_t i = 0; i < m_sprites.size(); ++i)
+        {
+            m_sprites[i].move(((index + i) % 3) - 1.f, 0.f);
+            target.draw(m_sprites[i]);
+        }
+    }
+
+private:
+
+    static const unsigned int TextureCount = 16;
+
+    sf::Texture m_textures[TextureCount];
+    std::vector<sf::Sprite> m_sprites;
+};
+
+
+////////////////////////////////////////////////////////////
+// Texts whose string changes every frame
+////////////////////////////////////////////////////////////
+class DynamicText : public Workload
+{
+public:
+
+    DynamicText(const Options& options) :
+    Workload("text_dynamic", scaled(200, options))
+    {
+    }
+
+    std::string setup(const Options& options, bool)
+    {
+        if (!m_font.loadFromFile(options.font))
+            return "failed to load the font " + options.font;
+
+        m_texts.resize(m_items);
+        for (std::size_t i = 0; i < m_texts.size(); ++i)
+        {
+            m_texts[i].setFont(m_font);
+            m_texts[i].setCharacterSize(12 + i % 4 * 4);
+            m_texts[i].setColor(randomColor());
+            m_texts[i].setPosition(randomFloat(static_cast<float>(options.width)), randomFloat(static_cast<float>(options.height)));
+        }
+
+        return "";
+    }
+
+    void frame(sf::RenderTarget& target, unsigned int index)
+    {
+        for (std::size_t i = 0; i < m_texts.size(); ++i)
+        {
+            std::ostringstream stream;
+            stream << "Score: " << (index * 7919 + i * 104729) % 1000000 << " pts";
+            m_texts[i].setString(stream.str());
+            target.draw(m_texts[i]);
+        }
+    }
+
+private:
+
+    sf::Font m_font;
+    std::vector<sf::Text> m_texts;
+};
+
+
+////////////////////////////////////////////////////////////
+// Shapes created, modified and destroyed every frame
+////////////////////////////////////////////////////////////
+class ShapeChurn : public Workload
+{
+public:
+
+    ShapeChurn(const Options& options) :
+    Workload("shape_churn", scaled(2000, options))
+    {
+    }
+
+    std::string setup(const Options& options, bool)
+    {
+        m_width = static_cast<float>(options.width);
+        m_height = static_cast<float>(options.height);
+
+        return "";
+    }
+
+    void frame(sf::RenderTarget& target, unsigned int index)
+    {
+        for (std::size_t i = 0; i < m_items; ++i)
+        {
+            sf::Vector2f position(randomFloat(m_width), randomFloat(m_height));
+            if ((i + index) % 2)
+            {
+                sf::CircleShape circle(4.f + i % 16, 8 + i % 24);
+                circle.setPosition(position);
+                circle.setFillColor(randomColor());
+                circle.setOutlineThickness(1.f);
+                circle.setOutlineColor(sf::Color::Black);
+                target.draw(circle);
+            }
+            else
+            {
+                sf::RectangleShape rectangle(sf::Vector2f(8.f + i % 16, 4.f + i % 8));
+                rectangle.setPosition(position);
+                rectangle.setRotation(static_cast<float>(i % 90));
+                rectangle.setFillColor(randomColor());
+                target.draw(rectangle);
+            }
+        }
+    }
+
+private:
+
+    float m_width;
+    float m_height;
+};
+
+
+////////////////////////////////////////////////////////////
+// Vertex array rebuilt and uploaded every frame
+////////////////////////////////////////////////////////////
+class VertexArrayStreaming : public Workload
+{
+public:
+
+    VertexArrayStreaming(const Options& options) :
+    Workload("vertex_array_streaming", scaled(50000, options)),
+    m_vertices(sf::Quads)
+    {
+    }
+
+    std::string setup(const Options& options, bool)
+    {
+        m_width = static_cast<float>(options.width);
+        m_height = static_cast<float>(options.height);
+        m_vertices.resize(m_items * 4);
+
+        return "";
+    }
+
+    void frame(sf::RenderTarget& target, unsigned int index)
+    {
+        for (std::size_t i = 0; i < m_items; ++i)
+        {
+            float x = static_cast<float>((i * 37 + index * 3) % static_cast<std::size_t>(m_width));
+            float y = static_cast<float>((i * 91 + index) % static_cast<std::size_t>(m_height));
+            sf::Color color(static_cast<sf::Uint8>(i), static_cast<sf::Uint8>(i >> 8), static_cast<sf::Uint8>(index));
+
+            sf::Vertex* quad = &m_vertices[i * 4];
+            quad[0] = sf::Vertex(sf::Vector2f(x, y), color);
+            quad[1] = sf::Vertex(sf::Vector2f(x + 4, y), color);
+            quad[2] = sf::Vertex(sf::Vector2f(x + 4, y + 4), color);
+            quad[3] = sf::Vertex(sf::Vector2f(x, y + 4), color);
+        }
+
+        target.draw(m_vertices);
+    }
+
+private:
+
+    float m_width;
+    float m_height;
+    sf::VertexArray m_vertices;
+};
+
+
+////////////////////////////////////////////////////////////
+// Rectangles drawn with alternating shaders and parameters
+////////////////////////////////////////////////////////////
+class ShaderSwitching : public Workload
+{
+public:
+
+    ShaderSwitching(const Options& options) :
+    Workload("shader_switching", scaled(2000, options))
+    {
+    }
+
+    std::string setup(const Options& options, bool software)
+    {
+        if (software)
+            return "shaders are not supported by the software render target";
+        if (!sf::Shader::isAvailable())
+            return "shaders are not available";
+
+        static const char* const sources[ShaderCount] =
+        {
+            "uniform vec4 color; void main() { gl_FragColor = gl_Color * color; }",
+            "uniform vec4 color; void main() { gl_FragColor = vec4(1.0) - gl_Color * color; }",
+            "uniform vec4 color; void main() { gl_FragColor = vec4(gl_Color.bgr * color.rgb, 1.0); }",
+            "uniform vec4 color; void main() { float l = dot(gl_Color.rgb, vec3(0.3, 0.6, 0.1)); gl_FragColor = vec4(vec3(l), 1.0) * color; }"
+        };
+
+        for (unsigned int i = 0; i < ShaderCount; ++i)
+        {
+            if (!m_shaders[i].loadFromMemory(sources[i], sf::Shader::Fragment))
+                return "failed to compile the shaders";
+        }
+
+        m_rectangles.resize(m_items);
+        for (std::size_t i = 0; i < m_rectangles.size(); ++i)
+        {
+            m_rectangles[i].setSize(sf::Vector2f(16.f, 16.f));
+            m_rectangles[i].setPosition(randomFloat(static_cast<float>(options.width)), randomFloat(static_cast<float>(options.height)));
+            m_rectangles[i].setFillColor(randomColor());
+        }
+
+        return "";
+    }
+
+    void frame(sf::RenderTarget& target, unsigned int index)
+    {
+        for (std::size_t i = 0; i < m_rectangles.size(); ++i)
+        {
+            sf::Shader& shader = m_shaders[i % ShaderCount];
+            shader.setParameter("color", sf::Color(255, static_cast<sf::Uint8>(index + i), 255));
+            target.draw(m_rectangles[i], &shader);
+        }
+    }
+
+private:
+
+    static const unsigned int ShaderCount = 4;
+
+    sf::Shader m_shaders[ShaderCount];
+    std::vector<sf::RectangleShape> m_rectangles;
+};
+
+
+////////////////////////////////////////////////////////////
+// Render textures drawn into each other (post-processing chain)
+////////////////////////////////////////////////////////////
+class RenderTexturePingPong : public Workload
+{
+public:
+
+    RenderTexturePingPong(const Options& options) :
+    Workload("render_texture_ping_pong", scaled(8, options))
+    {
+    }
+
+    std::string setup(const Options& options, bool software)
+    {
+        if (software)
+            return "render textures need OpenGL";
+
+        if (!m_textures[0].create(options.width, options.height) || !m_textures[1].create(options.width, options.height))
+            return "failed to create the render textures";
+
+        return "";
+    }
+
+    void frame(sf::RenderTarget& target, unsigned int index)
+    {
+        // Seed the chain with something that changes every frame
+        sf::RectangleShape seed(sf::Vector2f(100.f, 100.f));
+        seed.setPosition(static_cast<float>(index % 100), 50.f);
+        m_textures[0].clear(sf::Color(20, 20, 20));
+        m_textures[0].draw(seed);
+        m_textures[0].display();
+
+        // Each pass draws the previous result, slightly transformed and blended
+        for (std::size_t i = 0; i < m_items; ++i)
+        {
+            sf::RenderTexture& source = m_textures[i % 2];
+            sf::RenderTexture& destination = m_textures[(i + 1) % 2];
+
+            sf::Sprite sprite(source.getTexture());
+            sprite.setColor(sf::Color(255, 255, 255, 200));
+            destination.clear();
+            destination.draw(sprite);
+            sprite.setPosition(2.f, 1.f);
+            destination.draw(sprite, sf::BlendAdd);
+            destination.display();
+        }
+
+        target.draw(sf::Sprite(m_textures[m_items % 2].getTexture()));
+    }
+
+private:
+
+    sf::RenderTexture m_textures[2];
+};
+
+
+////////////////////////////////////////////////////////////
+// Measures of a workload
+////////////////////////////////////////////////////////////
+struct Result
+{
+    std::string name;
+    std::size_t items;
+    std::string skipped;
+    std::vector<double> times; // Frame times, in milliseconds, sorted
+};
+
+
+////////////////////////////////////////////////////////////
+// Render a frame and wait until it's finished
+////////////////////////////////////////////////////////////
+void renderFrame(sf::RenderTarget& target, Workload& workload, unsigned int index, sf::RenderTexture* glTarget, sf::SoftwareRenderTarget* softwareTarget)
+{
+    target.clear();
+    workload.frame(target, index);
+
+    if (glTarget)
+    {
+        glTarget->display();
+
+        // Make sure that the GPU is done, otherwise we only measure the submission
+        glTarget->setActive(true);
+        glFinish();
+    }
+    else
+    {
+        softwareTarget->display();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Run a workload and measure its frame times
+////////////////////////////////////////////////////////////
+Result run(Workload& workload, const Options& options, sf::RenderTarget& target, sf::RenderTexture* glTarget, sf::SoftwareRenderTarget* softwareTarget)
+{
+    Result result;
+    result.name = workload.getName();
+    result.items = workload.getItems();
+    result.skipped = workload.setup(options, softwareTarget != NULL);
+    if (!result.skipped.empty())
+        return result;
+
+    // Let caches, drivers and allocators reach their steady state
+    unsigned int index = 0;
+    for (unsigned int i = 0; i < options.warmup; ++i)
+        renderFrame(target, workload, index++, glTarget, softwareTarget);
+
+    sf::Clock clock;
+    for (unsigned int i = 0; i < options.frames; ++i)
+    {
+        clock.restart();
+        renderFrame(target, workload, index++, glTarget, softwareTarget);
+        result.times.push_back(clock.getElapsedTime().asMicroseconds() / 1000.0);
+    }
+
+    std::sort(result.times.begin(), result.times.end());
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+// Write the results as a JSON document
+////////////////////////////////////////////////////////////
+void writeResults(std::FILE* file, const Options& options, const std::string& renderer, const std::vector<Result>& results)
+{
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"benchmark\": \"sfml-graphics-bench\",\n");
+    std::fprintf(file, "  \"target\": \"%s\",\n", options.software ? "software" : "opengl");
+    std::fprintf(file, "  \"renderer\": %s,\n", quote(renderer).c_str());
+    std::fprintf(file, "  \"width\": %u,\n", options.width);
+    std::fprintf(file, "  \"height\": %u,\n", options.height);
+    std::fprintf(file, "  \"frames\": %u,\n", options.frames);
+    std::fprintf(file, "  \"results\": [");
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+        std::fprintf(file, "%s\n    {\"name\": %s, \"items\": %lu", i ? "," : "", quote(result.name).c_str(), static_cast<unsigned long>(result.items));
+
+        if (!result.skipped.empty() || result.times.empty())
+        {
+            std::fprintf(file, ", \"skipped\": %s}", quote(result.skipped).c_str());
+            continue;
+        }
+
+        const std::vector<double>& times = result.times;
+        double total = 0;
+        for (std::size_t j = 0; j < times.size(); ++j)
+            total += times[j];
+        double mean = total / times.size();
+
+        std::fprintf(file, ", \"mean_ms\": %.3f, \"median_ms\": %.3f, \"p95_ms\": %.3f, \"min_ms\": %.3f, \"max_ms\": %.3f, \"fps\": %.1f, \"items_per_second\": %.0f}",
+                     mean,
+                     times[times.size() / 2],
+                     times[std::min(times.size() - 1, times.size() * 95 / 100)],
+                     times.front(),
+                     times.back(),
+                     1000.0 / mean,
+                     result.items * 1000.0 / mean);
+    }
+
+    std::fprintf(file, "\n  ]\n}\n");
+}
+
+
+////////////////////////////////////////////////////////////
+// Print the usage
+////////////////////////////////////////////////////////////
+void usage()
+{
+    std::printf("Usage: sfml-graphics-bench [options]\n"
+                "  --size WxH        Size of the render target (default 800x600)\n"
+                "  --frames N        Number of measured frames per workload (default 100)\n"
+                "  --warmup N        Number of frames rendered before measuring (default 10)\n"
+                "  --scale F         Factor applied to the number of items (default 1)\n"
+                "  --software        Use sf::SoftwareRenderTarget instead of OpenGL\n"
+                "  --threads N       Threads of the software render target (default 1)\n"
+                "  --font FILE       Font used by the text workload\n"
+                "  --filter NAME     Only run the workloads whose name contains NAME\n"
+                "  --output FILE     Write the JSON results to FILE instead of the standard output\n"
+                "\n"
+                "On Linux, with SFML built with SFML_EGL_HEADLESS, run it with SFML_HEADLESS=1\n"
+                "(and LIBGL_ALWAYS_SOFTWARE=1 for Mesa's software renderer) to measure without\n"
+                "a display server nor a GPU.\n");
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Parse the command line
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ((option == "--size") && hasValue && (std::sscanf(argv[i + 1], "%ux%u", &options.width, &options.height) == 2))
+            ++i;
+        else if ((option == "--frames") && hasValue)
+            options.frames = std::strtoul(argv[++i], NULL, 10);
+        else if ((option == "--warmup") && hasValue)
+            options.warmup = std::strtoul(argv[++i], NULL, 10);
+        else if ((option == "--scale") && hasValue)
+            options.scale = static_cast<float>(std::atof(argv[++i]));
+        else if (option == "--software")
+            options.software = true;
+        else if ((option == "--threads") && hasValue)
+            options.threads = std::strtoul(argv[++i], NULL, 10);
+        else if ((option == "--font") && hasValue)
+            options.font = argv[++i];
+        else if ((option == "--filter") && hasValue)
+            options.filter = argv[++i];
+        else if ((option == "--output") && hasValue)
+            options.output = argv[++i];
+        else
+        {
+            usage();
+            return option == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if ((options.width == 0) || (options.height == 0) || (options.frames == 0) || (options.scale <= 0.f))
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    // Create the render target
+    sf::RenderTexture glTarget;
+    sf::SoftwareRenderTarget softwareTarget;
+    std::string renderer;
+    if (options.software)
+    {
+        if (!softwareTarget.create(options.width, options.height))
+            return EXIT_FAILURE;
+        softwareTarget.setThreadCount(options.threads);
+        renderer = "sf::SoftwareRenderTarget";
+    }
+    else
+    {
+        if (!glTarget.create(options.width, options.height))
+            return EXIT_FAILURE;
+        glTarget.setActive(true);
+        const GLubyte* name = glGetString(GL_RENDERER);
+        renderer = name ? reinterpret_cast<const char*>(name) : "unknown";
+    }
+
+    sf::RenderTarget& target = options.software ? static_cast<sf::RenderTarget&>(softwareTarget) : static_cast<sf::RenderTarget&>(glTarget);
+
+    // Create the workloads
+    std::vector<Workload*> workloads;
+    workloads.push_back(new SpritesOneTexture(options));
+    workloads.push_back(new SpritesManyTextures(options));
+    workloads.push_back(new DynamicText(options));
+    workloads.push_back(new ShapeChurn(options));
+    workloads.push_back(new VertexArrayStreaming(options));
+    workloads.push_back(new ShaderSwitching(options));
+    workloads.push_back(new RenderTexturePingPong(options));
+
+    // Run them
+    std::vector<Result> results;
+    for (std::size_t i = 0; i < workloads.size(); ++i)
+    {
+        if (workloads[i]->getName().find(options.filter) != std::string::npos)
+        {
+            std::fprintf(stderr, "Running %s...\n", workloads[i]->getName().c_str());
+            results.push_back(run(*workloads[i], options, target,
+                                  options.software ? NULL : &glTarget,
+                                  options.software ? &softwareTarget : NULL));
+        }
+
+        delete workloads[i];
+    }
+
+    // Write the results
+    std::FILE* file = options.output.empty() ? stdout : std::fopen(options.output.c_str(), "w");
+    if (!file)
+    {
+        std::fprintf(stderr, "Failed to open %s\n", options.output.c_str());
+        return EXIT_FAILURE;
+    }
+
+    writeResults(file, options, renderer, results);
+
+    if (file != stdout)
+        std::fclose(file);
+
+    return EXIT_SUCCESS;
+}
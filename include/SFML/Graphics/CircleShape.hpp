@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Shape.hpp>
+#include <vector>
 
 
 namespace sf
@@ -106,13 +107,37 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2f getPoint(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose the number of points from the size of the circle on a target
+    ///
+    /// This function sets the number of points to the smallest
+    /// one such that the polygon doesn't deviate from the true
+    /// circle by more than a quarter of a pixel, given the
+    /// current view of \a target and the transform of the
+    /// circle combined with \a transform (the transform of the
+    /// render states it will be drawn with). Small circles thus
+    /// use only a few points, while big ones stay smooth.
+    ///
+    /// The result is applied with setPointCount, so it is what
+    /// getPointCount returns afterwards. Call this function again
+    /// when the view or the transform changes significantly.
+    ///
+    /// \param target    Render target the circle will be drawn to
+    /// \param transform Additional transform applied when the circle is drawn
+    ///
+    /// \see setPointCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateLevelOfDetail(const RenderTarget& target, const Transform& transform = Transform::Identity);
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float       m_radius;     ///< Radius of the circle
-    std::size_t m_pointCount; ///< Number of points composing the circle
+    float                        m_radius;     ///< Radius of the circle
+    std::size_t                  m_pointCount; ///< Number of points composing the circle
+    const std::vector<Vector2f>* m_unitCircle; ///< Shared table of the points of the unit circle, NULL if not cached
 };
 
 } // namespace sf
@@ -149,6 +174,11 @@ private:
 /// small numbers you can create any regular polygon shape:
 /// equilateral triangle, square, pentagon, hexagon, ...
 ///
+/// When many circles of various sizes are displayed, for example
+/// particles or debug markers, updateLevelOfDetail can be called
+/// when the view changes, so that each circle only uses the
+/// number of points it needs to look round on screen.
+///
 /// \see sf::Shape, sf::RectangleShape, sf::ConvexShape
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPACTVERTEX_HPP
+#define SFML_COMPACTVERTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Define a point with color and texture coordinates, stored in 12 bytes
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API CompactVertex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position
+    ///
+    /// The vertex color is white and texture coordinates are (0, 0).
+    ///
+    /// \param thePosition Vertex position
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex(const Vector2<Int16>& thePosition);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position and color
+    ///
+    /// The texture coordinates are (0, 0).
+    ///
+    /// \param thePosition Vertex position
+    /// \param theColor    Vertex color
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex(const Vector2<Int16>& thePosition, const Color& theColor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position and texture coordinates
+    ///
+    /// The vertex color is white.
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theTexCoords Vertex texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex(const Vector2<Int16>& thePosition, const Vector2<Int16>& theTexCoords);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position, color and texture coordinates
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theColor     Vertex color
+    /// \param theTexCoords Vertex texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex(const Vector2<Int16>& thePosition, const Color& theColor, const Vector2<Int16>& theTexCoords);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from a regular vertex
+    ///
+    /// The position and texture coordinates are rounded to the
+    /// nearest integers. Values outside the range of Int16
+    /// ([-32768, 32767]) are clamped to it, so vertices beyond
+    /// that range should rather be offset by the transform of
+    /// the render states.
+    ///
+    /// \param vertex Vertex to convert
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CompactVertex(const Vertex& vertex);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2<Int16> position;  ///< 2D position of the vertex
+    Color          color;     ///< Color of the vertex
+    Vector2<Int16> texCoords; ///< Coordinates of the texture's pixel to map to the vertex
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPACTVERTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompactVertex
+/// \ingroup graphics
+///
+/// sf::CompactVertex holds the same attributes as sf::Vertex,
+/// but its position and texture coordinates are 16-bit integers
+/// instead of floats: it takes 12 bytes instead of 20, which
+/// almost halves the memory and the bandwidth used by big
+/// static meshes, such as tile maps.
+///
+/// Like with sf::Vertex, texture coordinates are given in
+/// pixels. Positions are in local coordinates, the transform
+/// of the render states is applied to them as usual; they can
+/// be scaled by this transform when a finer or coarser grid
+/// than whole units is needed.
+///
+/// Compact vertices are drawn directly by sf::RenderTarget,
+/// or stored in a sf::CompactVertexArray.
+///
+/// Example:
+/// \code
+/// // define a 32x32 tile, with the 16x16 top-left area of a texture mapped on it
+/// sf::CompactVertex vertices[] =
+/// {
+///     sf::CompactVertex(sf::Vector2<sf::Int16>( 0,  0), sf::Vector2<sf::Int16>( 0,  0)),
+///     sf::CompactVertex(sf::Vector2<sf::Int16>(32,  0), sf::Vector2<sf::Int16>(16,  0)),
+///     sf::CompactVertex(sf::Vector2<sf::Int16>( 0, 32), sf::Vector2<sf::Int16>( 0, 16)),
+///     sf::CompactVertex(sf::Vector2<sf::Int16>(32, 32), sf::Vector2<sf::Int16>(16, 16))
+/// };
+///
+/// sf::RenderStates states(&texture);
+/// window.draw(vertices, 4, sf::TrianglesStrip, states);
+/// \endcode
+///
+/// \see sf::Vertex, sf::CompactVertexArray
+///
+////////////////////////////////////////////////////////////
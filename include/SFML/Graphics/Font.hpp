@@ -34,8 +34,10 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
+#include <deque>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -60,6 +62,16 @@ public:
         std::string family; ///< The font family
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Parameters of the distance field glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        DistanceFieldSize   = 64, ///< Character size of the distance field glyphs, in pixels
+        DistanceFieldSpread = 8   ///< Distance covered by the fields on each side of the outlines, in pixels at DistanceFieldSize
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -175,6 +187,53 @@ public:
     ////////////////////////////////////////////////////////////
     const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the metrics of a glyph of the font
+    ///
+    /// Unlike getGlyph, this function never rasterizes the glyph
+    /// nor touches the textures of the font: only the advance and
+    /// the bounds of the returned glyph are relevant, its texture
+    /// rect is empty unless the glyph was already loaded. It is
+    /// therefore much cheaper for glyphs which are measured but
+    /// not drawn.
+    ///
+    /// \param codePoint     Unicode code point of the character to get
+    /// \param characterSize Reference character size
+    /// \param bold          Retrieve the bold version or the regular one?
+    ///
+    /// \return The metrics of the glyph corresponding to \a codePoint and \a characterSize
+    ///
+    /// \see getGlyph, measure
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& getGlyphMetrics(Uint32 codePoint, unsigned int characterSize, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a glyph of the font as a signed distance field
+    ///
+    /// Distance field glyphs are rasterized once, at the reference
+    /// character size DistanceFieldSize, and can be drawn at any
+    /// scale with a shader that thresholds the field (see
+    /// sf::Text::setDistanceFieldEnabled). The alpha channel of
+    /// their texture holds the distance to the outline of the glyph,
+    /// mapped so that 0.5 is on the outline, 1 is DistanceFieldSpread
+    /// pixels inside and 0 is DistanceFieldSpread pixels outside.
+    ///
+    /// The metrics of the returned glyph are given for the reference
+    /// size; its texture rect covers the glyph's bounds only, but the
+    /// field extends DistanceFieldSpread pixels beyond it.
+    ///
+    /// Only scalable fonts can produce distance field glyphs.
+    ///
+    /// \param codePoint Unicode code point of the character to get
+    ///
+    /// \return The distance field glyph corresponding to \a codePoint
+    ///
+    /// \see getDistanceFieldTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& getDistanceFieldGlyph(Uint32 codePoint) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the kerning offset of two glyphs
     ///
@@ -193,6 +252,119 @@ public:
     ////////////////////////////////////////////////////////////
     float getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounds of a string displayed with this font
+    ///
+    /// The returned rectangle is the same as the local bounds of
+    /// a sf::Text with the same string, character size and style
+    /// (without distance field rendering), but it is computed
+    /// from the glyph metrics only: no geometry is built and no
+    /// glyph is rasterized.
+    ///
+    /// \param string        String to measure
+    /// \param characterSize Reference character size
+    /// \param style         Combination of sf::Text::Style flags
+    ///
+    /// \return Bounding rectangle of the string, in local coordinates
+    ///
+    /// \see wrap, getGlyphMetrics
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect measure(const String& string, unsigned int characterSize, Uint32 style = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert line breaks in a string so that its lines fit a given width
+    ///
+    /// Lines are broken at the last space or tab which keeps them
+    /// within \a width, the space being replaced by the line
+    /// break. Words wider than \a width are broken between two
+    /// characters. Existing line breaks are kept. Widths are
+    /// measured with the advances of the glyphs, as sf::Text
+    /// lays them out.
+    ///
+    /// Like measure, this function only uses the glyph metrics.
+    ///
+    /// \param string        String to wrap
+    /// \param characterSize Reference character size
+    /// \param width         Maximum width of the lines, in pixels
+    /// \param style         Combination of sf::Text::Style flags
+    ///
+    /// \return The wrapped string
+    ///
+    /// \see measure
+    ///
+    ////////////////////////////////////////////////////////////
+    String wrap(const String& string, unsigned int characterSize, float width, Uint32 style = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs in advance
+    ///
+    /// Glyphs are normally loaded on demand, the first time that
+    /// getGlyph is called for them, which can cause a noticeable
+    /// stall when a lot of new characters are displayed at once.
+    /// This function loads all the glyphs of the given ranges of
+    /// characters, for all the given character sizes, so that
+    /// subsequent calls to getGlyph for them are immediate.
+    ///
+    /// The glyphs are rasterized in parallel on \a threadCount
+    /// worker threads, each with its own copy of the font face;
+    /// they are then written to the textures by the calling
+    /// thread, which must therefore be allowed to use OpenGL.
+    /// Characters missing from the font and glyphs that are
+    /// already loaded are skipped.
+    ///
+    /// \param ranges      Ranges of Unicode code points to load (both ends included)
+    /// \param sizes       Character sizes to load the glyphs for
+    /// \param bold        Load the bold version or the regular one?
+    /// \param threadCount Maximum number of worker threads to use
+    ///
+    /// \see getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphs(const std::vector<std::pair<Uint32, Uint32> >& ranges, const std::vector<unsigned int>& sizes, bool bold = false, unsigned int threadCount = 4) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the loaded glyphs of some character sizes to a cache file
+    ///
+    /// The cache file contains the glyph textures, the metrics of
+    /// the glyphs and the kerning offsets already computed for the
+    /// requested sizes, so that loadCache can restore them on the
+    /// next run without rasterizing anything. Character size 0
+    /// stands for the distance field glyphs.
+    ///
+    /// Sizes for which no glyph was loaded are ignored. This
+    /// function is typically used after preloadGlyphs.
+    ///
+    /// \param filename Path of the cache file to write
+    /// \param sizes    Character sizes to save
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see loadCache, preloadGlyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveCache(const std::string& filename, const std::vector<unsigned int>& sizes) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load glyphs from a cache file written by saveCache
+    ///
+    /// The cache file stores a hash of the font data it was built
+    /// from: if it doesn't match the loaded font, or if the file is
+    /// invalid, nothing is loaded and this function returns false;
+    /// the glyphs will then be rasterized on demand as usual.
+    ///
+    /// Character sizes that already have glyphs loaded in this
+    /// font are left untouched.
+    ///
+    /// \param filename Path of the cache file to read
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see saveCache
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCache(const std::string& filename) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the line spacing
     ///
@@ -249,6 +421,33 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fraction of a glyph texture which is used by glyphs
+    ///
+    /// This is the ratio between the area allocated to the loaded
+    /// glyphs of the given size (padding included) and the total
+    /// area of their texture. It is mainly useful to tune the
+    /// character sizes and sets of glyphs used by an application.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Occupancy of the texture, in range [0 .. 1] (0 if no glyph of this size was loaded)
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    float getTextureOccupancy(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the texture containing the loaded distance field glyphs
+    ///
+    /// \return Texture containing the distance field glyphs
+    ///
+    /// \see getDistanceFieldGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getDistanceFieldTexture() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -262,22 +461,50 @@ public:
 private:
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
+    /// \brief Structure defining a segment of the skyline of a page
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SkylineNode
+    {
+        SkylineNode(unsigned int nodeX, unsigned int nodeY, unsigned int nodeWidth) : x(nodeX), y(nodeY), width(nodeWidth) {}
+
+        unsigned int x;     ///< X position of the segment into the texture
+        unsigned int y;     ///< Y position of the first free pixel above the segment
+        unsigned int width; ///< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a slot of the glyph hash table
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphSlot
+    {
+        GlyphSlot() : key(0), index(0) {}
+        GlyphSlot(Uint64 slotKey, std::size_t slotIndex) : key(slotKey), index(slotIndex) {}
+
+        Uint64      key;   ///< Combination of the character size, the style and the code point
+        std::size_t index; ///< Index of the glyph in the glyph storage plus one, 0 if the slot is empty
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a slot of the kerning hash table
     ///
     ////////////////////////////////////////////////////////////
-    struct Row
+    struct KerningSlot
     {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
+        KerningSlot() : key(0), value(0.f), used(false) {}
+        KerningSlot(Uint64 slotKey, float slotValue) : key(slotKey), value(slotValue), used(true) {}
 
-        unsigned int width;  ///< Current width of the row
-        unsigned int top;    ///< Y position of the row into the texture
-        unsigned int height; ///< Height of the row
+        Uint64 key;   ///< Combination of the character size and the two code points
+        float  value; ///< Kerning offset of the pair, in pixels
+        bool   used;  ///< Is the slot occupied?
     };
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint32, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    typedef std::vector<GlyphSlot>   GlyphTable;   ///< Open-addressing hash table mapping a glyph key to its glyph
+    typedef std::vector<KerningSlot> KerningTable; ///< Open-addressing hash table mapping a pair of characters to its kerning
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -287,10 +514,23 @@ private:
     {
         Page();
 
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        Texture          texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        Texture                  texture;  ///< Texture containing the pixels of the glyphs
+        std::vector<SkylineNode> skyline;  ///< Top outline of the allocated area, sorted from left to right
+        unsigned int             usedArea; ///< Number of pixels allocated to glyphs (padding included)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a page read from a cache file
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CachedPage
+    {
+        Uint32                   size;     ///< Character size of the page
+        Uint32                   width;    ///< Width of the texture
+        Uint32                   height;   ///< Height of the texture
+        Uint32                   usedArea; ///< Number of pixels allocated to glyphs
+        std::vector<SkylineNode> skyline;  ///< Top outline of the allocated area
+        const Uint8*             alpha;    ///< Alpha channel of the texture, in the file's buffer
     };
 
     ////////////////////////////////////////////////////////////
@@ -299,6 +539,48 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the slot of a glyph in the hash table
+    ///
+    /// The glyph table must not be empty.
+    ///
+    /// \param key Key of the glyph
+    ///
+    /// \return Index of the slot holding \a key, or of the empty slot where it would be inserted
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findGlyphSlot(Uint64 key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a glyph in the hash table, growing it if necessary
+    ///
+    /// \param key   Key of the glyph
+    /// \param index Index of the glyph in the glyph storage, plus one
+    ///
+    ////////////////////////////////////////////////////////////
+    void insertGlyph(Uint64 key, std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the slot of a pair of characters in the kerning hash table
+    ///
+    /// The kerning table must not be empty.
+    ///
+    /// \param key Key of the pair
+    ///
+    /// \return Index of the slot holding \a key, or of the empty slot where it would be inserted
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findKerningSlot(Uint64 key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a kerning offset in the hash table, growing it if necessary
+    ///
+    /// \param key     Key of the pair
+    /// \param kerning Kerning offset of the pair, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void insertKerning(Uint64 key, float kerning) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
@@ -311,9 +593,47 @@ private:
     ////////////////////////////////////////////////////////////
     Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a new distance field glyph
+    ///
+    /// \param codePoint Unicode code point of the character to load
+    ///
+    /// \return The distance field glyph corresponding to \a codePoint
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph loadDistanceFieldGlyph(Uint32 codePoint) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the metrics of a glyph without rasterizing it
+    ///
+    /// \param codePoint     Unicode code point of the character to load
+    /// \param characterSize Reference character size
+    /// \param bold          Retrieve the bold version or the regular one?
+    ///
+    /// \return The glyph corresponding to \a codePoint and \a characterSize, with an empty texture rect
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph loadGlyphMetrics(Uint32 codePoint, unsigned int characterSize, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the pixels of a rasterized glyph to the texture of its page
+    ///
+    /// On input, the texture rect of \a glyph holds the size of
+    /// its bitmap; on output, it holds its position in the texture.
+    ///
+    /// \param glyph         Glyph to write
+    /// \param characterSize Reference character size
+    /// \param pixels        RGBA pixels of the glyph
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeGlyph(Glyph& glyph, unsigned int characterSize, const std::vector<Uint8>& pixels) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
     ///
+    /// Rectangles are allocated with the bottom-left skyline
+    /// heuristic; when no position fits, the texture is grown.
+    ///
     /// \param page   Page of glyphs to search in
     /// \param width  Width of the rectangle
     /// \param height Height of the rectangle
@@ -333,21 +653,41 @@ private:
     ////////////////////////////////////////////////////////////
     bool setCurrentSize(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Double the size of the texture of a page
+    ///
+    /// The existing glyphs are copied on the GPU side, they
+    /// keep their position in the texture. Only the new area
+    /// is uploaded from system memory, as transparent pixels.
+    ///
+    /// \param page Page of glyphs to grow
+    ///
+    /// \return True on success, false if the maximum texture size is reached
+    ///
+    ////////////////////////////////////////////////////////////
+    bool growPage(Page& page) const;
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, Page> PageTable;  ///< Table mapping a character size to its page (texture), 0 for the distance field glyphs
+    typedef std::map<unsigned int, void*> SizeTable; ///< Table mapping a character size to its FreeType size object
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    void*                      m_library;     ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
-    void*                      m_face;        ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
-    void*                      m_streamRec;   ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
-    int*                       m_refCount;    ///< Reference counter used by implicit sharing
-    Info                       m_info;        ///< Information about the font
-    mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    void*                      m_library;      ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
+    void*                      m_face;         ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
+    void*                      m_streamRec;    ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
+    int*                       m_refCount;     ///< Reference counter used by implicit sharing
+    Info                       m_info;         ///< Information about the font
+    mutable PageTable          m_pages;        ///< Table containing the glyphs pages by character size
+    mutable GlyphTable         m_glyphTable;   ///< Hash table indexing the loaded glyphs and glyph metrics
+    mutable std::deque<Glyph>  m_glyphs;       ///< Storage of the loaded glyphs (a deque, so that references stay valid)
+    mutable KerningTable       m_kerningTable; ///< Hash table caching the kerning of the pairs already requested
+    mutable std::size_t        m_kerningCount; ///< Number of pairs stored in the kerning table
+    mutable SizeTable          m_sizes;        ///< FreeType size objects of the character sizes in use (they are typeless to avoid exposing implementation details)
+    mutable std::vector<Uint8> m_pixelBuffer;  ///< Pixel buffer holding a glyph's pixels before being written to the texture
     #ifdef SFML_SYSTEM_ANDROID
     void*                      m_stream; ///< Asset file streamer (if loaded from file)
     #endif
@@ -155,6 +155,88 @@ public:
     ////////////////////////////////////////////////////////////
     bool saveToFile(const std::string& filename) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a buffer in memory
+    ///
+    /// The supported image formats are bmp, png, tga and jpg.
+    /// This function fails if the image is empty, or if
+    /// the format was invalid.
+    ///
+    /// \a compression controls the trade-off between speed and
+    /// size of PNG files: 0 stores the pixels uncompressed,
+    /// 1 to 3 select a fast mode (cheap row filters and a
+    /// single-probe deflate), and 4 to 9 try all the row filters
+    /// with an increasingly thorough deflate. \a quality is only
+    /// used by the jpg format.
+    ///
+    /// \param output      Buffer to fill with encoded data
+    /// \param format      Encoding format to use ("bmp", "png", "tga" or "jpg")
+    /// \param compression PNG compression level, from 0 (fastest) to 9 (smallest)
+    /// \param quality     JPEG quality, from 1 (smallest) to 100 (best)
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see create, saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToMemory(std::vector<Uint8>& output, const std::string& format, unsigned int compression = 6, unsigned int quality = 90) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the size and channel count of an image file on disk
+    ///
+    /// Only the header of the file is parsed, the pixels are
+    /// not decoded. This is much faster than loading the
+    /// image when only its properties are needed.
+    /// The channel count is the one stored in the file (1 for
+    /// grey, 2 for grey + alpha, 3 for RGB, 4 for RGBA); loaded
+    /// images are always converted to RGBA.
+    ///
+    /// \param filename     Path of the image file to probe
+    /// \param size         Variable to fill with the size of the image, in pixels
+    /// \param channelCount Variable to fill with the number of channels
+    ///
+    /// \return True if the image header could be read
+    ///
+    /// \see loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getInfo(const std::string& filename, Vector2u& size, unsigned int& channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the size and channel count of an image file in memory
+    ///
+    /// Only the header of the file is parsed, the pixels are
+    /// not decoded.
+    ///
+    /// \param data         Pointer to the file data in memory
+    /// \param dataSize     Size of the data, in bytes
+    /// \param size         Variable to fill with the size of the image, in pixels
+    /// \param channelCount Variable to fill with the number of channels
+    ///
+    /// \return True if the image header could be read
+    ///
+    /// \see loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getInfo(const void* data, std::size_t dataSize, Vector2u& size, unsigned int& channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the size and channel count of an image from a custom stream
+    ///
+    /// Only the header of the file is parsed, the pixels are
+    /// not decoded: only the first bytes of the stream are read.
+    ///
+    /// \param stream       Source stream to read from
+    /// \param size         Variable to fill with the size of the image, in pixels
+    /// \param channelCount Variable to fill with the number of channels
+    ///
+    /// \return True if the image header could be read
+    ///
+    /// \see loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getInfo(InputStream& stream, Vector2u& size, unsigned int& channelCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
     ///
@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEBATCHLOADER_HPP
+#define SFML_IMAGEBATCHLOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Thread;
+
+////////////////////////////////////////////////////////////
+/// \brief Decode many image files in parallel on worker threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageBatchLoader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enumeration of the loading states of an image
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Pending, ///< Image is waiting to be (or being) decoded
+        Loaded,  ///< Image was decoded successfully
+        Failed   ///< Image could not be loaded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageBatchLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The destructor waits until all the worker threads
+    /// have finished.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageBatchLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading a batch of image files
+    ///
+    /// This function returns immediately, the files are decoded
+    /// in the background by \a threadCount worker threads. The
+    /// index of each image in the batch is its index in the
+    /// \a filenames array.
+    /// If a previous batch is still being loaded, this function
+    /// waits for it to finish before starting the new one; the
+    /// images of the previous batch are discarded.
+    ///
+    /// \param filenames   Paths of the image files to load
+    /// \param threadCount Number of worker threads to use
+    ///
+    /// \see wait, pollCompleted
+    ///
+    ////////////////////////////////////////////////////////////
+    void launch(const std::vector<std::string>& filenames, unsigned int threadCount = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the images of the batch are processed
+    ///
+    /// \see launch, isFinished
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether all the images of the batch are processed
+    ///
+    /// \return True if no image is pending anymore
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFinished() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images in the batch
+    ///
+    /// \return Number of images
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the loading state of an image of the batch
+    ///
+    /// \param index Index of the image in the batch
+    ///
+    /// \return Current status of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getStatus(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an image of the batch
+    ///
+    /// The image must not be accessed while its status is
+    /// still sf::ImageBatchLoader::Pending. If it failed to
+    /// load, an empty image is returned. This function must
+    /// be called by the thread that owns the loader, since
+    /// launch() discards the images.
+    ///
+    /// \param index Index of the image in the batch
+    ///
+    /// \return Reference to the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getImage(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop the next processed image from the completion queue
+    ///
+    /// Each image is returned exactly once by this function,
+    /// in the order in which the workers finished them. This
+    /// function never blocks: it is meant to be called regularly
+    /// by the thread that owns the OpenGL context, so that it
+    /// can upload the images to textures as soon as they are ready.
+    ///
+    /// \param index Variable to fill with the index of the image
+    ///
+    /// \return True if an image was popped, false if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pollCompleted(std::size_t& index);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void work();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<std::string> m_filenames;    ///< Paths of the files to load
+    std::vector<Image>       m_images;       ///< Decoded images
+    std::vector<Status>      m_status;       ///< Loading state of each image
+    std::vector<Thread*>     m_workers;      ///< Worker threads
+    std::deque<std::size_t>  m_completed;    ///< Indices of the processed images not yet polled
+    std::size_t              m_nextJob;      ///< Index of the next image to decode
+    std::size_t              m_done;         ///< Number of processed images
+    mutable Mutex            m_mutex;        ///< Mutex protecting the state shared with the workers
+    Mutex                    m_workersMutex; ///< Mutex protecting the list of workers
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEBATCHLOADER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageBatchLoader
+/// \ingroup graphics
+///
+/// sf::ImageBatchLoader decodes a list of image files on a
+/// pool of worker threads. Decoding compressed formats such
+/// as PNG is CPU-bound, so spreading a large batch over
+/// several cores greatly reduces loading times.
+///
+/// Only the decoding happens in the background: creating
+/// textures requires an OpenGL context, so the uploads must
+/// stay on the thread that owns it. This thread retrieves the
+/// images as they are finished with pollCompleted().
+///
+/// launch(), wait() and getImage() must be called by the thread
+/// that owns the loader: launch() replaces the images that
+/// getImage() returns. isFinished(), getCount(), getStatus()
+/// and pollCompleted() can be called from any thread.
+///
+/// The images are decoded concurrently, so when several of
+/// them fail to load at the same time, the reasons printed
+/// to sf::err() may be interleaved or reported for the wrong
+/// file. The status of each image is always accurate.
+///
+/// Usage example:
+/// \code
+/// std::vector<std::string> files;
+/// files.push_back("background.png");
+/// files.push_back("player.png");
+/// ...
+///
+/// sf::ImageBatchLoader loader;
+/// loader.launch(files);
+///
+/// std::vector<sf::Texture> textures(files.size());
+/// while (window.isOpen())
+/// {
+///     // Upload the images that are ready
+///     std::size_t index;
+///     while (loader.pollCompleted(index))
+///     {
+///         if (loader.getStatus(index) == sf::ImageBatchLoader::Loaded)
+///             textures[index].loadFromImage(loader.getImage(index));
+///     }
+///
+///     ...
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INDEXARRAY_HPP
+#define SFML_INDEXARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Define a set of indices referring to the vertices of a vertex array
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API IndexArray
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty index array.
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the index array with an initial number of indices
+    ///
+    /// The indices are initialized to 0.
+    ///
+    /// \param indexCount Initial number of indices in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IndexArray(std::size_t indexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the index count
+    ///
+    /// \return Number of indices in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIndexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value of an index
+    ///
+    /// This function doesn't check \a position, it must be in
+    /// range [0, getIndexCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param position Position of the index to get
+    ///
+    /// \return Value of the position-th index
+    ///
+    /// \see setIndex, getIndexCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 operator [](std::size_t position) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the value of an index
+    ///
+    /// This function doesn't check \a position, it must be in
+    /// range [0, getIndexCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param position Position of the index to change
+    /// \param value    New value of the index
+    ///
+    /// \see operator[]
+    ///
+    ////////////////////////////////////////////////////////////
+    void setIndex(std::size_t position, Uint32 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the index array
+    ///
+    /// This function removes all the indices from the array, and
+    /// switches it back to 16-bit storage. It doesn't deallocate
+    /// the corresponding memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the index array
+    ///
+    /// If \a indexCount is greater than the current size, the previous
+    /// indices are kept and new indices with value 0 are added.
+    /// If \a indexCount is less than the current size, existing indices
+    /// are removed from the array, and the array switches back to
+    /// 16-bit storage if all the remaining indices fit.
+    ///
+    /// \param indexCount New size of the array (number of indices)
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t indexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an index to the array
+    ///
+    /// \param value Index to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(Uint32 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the indices of the two triangles of a quad
+    ///
+    /// The quad is made of the four consecutive vertices starting
+    /// at \a first: top-left, top-right, bottom-left and
+    /// bottom-right. This function is meant to be used with the
+    /// sf::Triangles primitive type.
+    ///
+    /// \param first Index of the first vertex of the quad
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendQuad(Uint32 first);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the indices are stored on 32 bits
+    ///
+    /// Indices are stored on 16 bits as long as they all fit,
+    /// which halves the memory and bandwidth they use. The array
+    /// switches to 32 bits as soon as a greater index is stored,
+    /// and back to 16 bits when it is cleared or shrunk below
+    /// its greater indices.
+    ///
+    /// \return True if the indices are 32-bit, false if they are 16-bit
+    ///
+    ////////////////////////////////////////////////////////////
+    bool is32Bits() const;
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Switch the storage of the indices to 32 bits
+    ///
+    ////////////////////////////////////////////////////////////
+    void convertTo32Bits();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Switch the storage of the indices back to 16 bits if they all fit
+    ///
+    ////////////////////////////////////////////////////////////
+    void convertTo16BitsIfPossible();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Uint16> m_indices16; ///< Indices, while they fit on 16 bits
+    std::vector<Uint32> m_indices32; ///< Indices, once one of them needed 32 bits
+    bool                m_32Bits;    ///< Are the indices stored in m_indices32?
+};
+
+} // namespace sf
+
+
+#endif // SFML_INDEXARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::IndexArray
+/// \ingroup graphics
+///
+/// sf::IndexArray is a dynamic array of indices, which tells
+/// in which order the vertices of a vertex array form its
+/// primitives. Vertices shared by several primitives can
+/// then be stored only once: a quad drawn with sf::Triangles
+/// needs 4 vertices and 6 indices instead of 6 vertices.
+///
+/// Indices are stored on 16 bits when possible, and
+/// automatically switch to 32 bits when needed. Note that
+/// 32-bit indices are not supported on OpenGL ES platforms.
+///
+/// Index arrays are not drawable by themselves, they are
+/// drawn along with the vertices they refer to.
+///
+/// Example:
+/// \code
+/// sf::VertexArray vertices(sf::Triangles, 4);
+/// vertices[0].position = sf::Vector2f(0, 0);
+/// vertices[1].position = sf::Vector2f(100, 0);
+/// vertices[2].position = sf::Vector2f(0, 100);
+/// vertices[3].position = sf::Vector2f(100, 100);
+///
+/// sf::IndexArray indices;
+/// indices.appendQuad(0);
+///
+/// window.draw(vertices, indices);
+/// \endcode
+///
+/// \see sf::VertexArray, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
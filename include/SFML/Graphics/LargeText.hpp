@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_LARGETEXT_HPP
+#define SFML_LARGETEXT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/String.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Graphical text optimized for very long strings
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API LargeText : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty text.
+    ///
+    ////////////////////////////////////////////////////////////
+    LargeText();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the text from a string, font and size
+    ///
+    /// \param string        Text assigned to the string
+    /// \param font          Font used to draw the string
+    /// \param characterSize Base size of characters, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    LargeText(const String& string, const Font& font, unsigned int characterSize = 30);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's string
+    ///
+    /// Only the positions of the line breaks are computed by
+    /// this function; the geometry of the lines is generated
+    /// when they become visible.
+    ///
+    /// \param string New string
+    ///
+    /// \see getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void setString(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's font
+    ///
+    /// The \a font argument refers to a font that must
+    /// exist as long as the text uses it.
+    ///
+    /// \param font New font
+    ///
+    /// \see getFont
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the character size
+    ///
+    /// The default size is 30.
+    ///
+    /// \param size New character size, in pixels
+    ///
+    /// \see getCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCharacterSize(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's style
+    ///
+    /// Only the sf::Text::Bold and sf::Text::Italic styles are
+    /// supported, the other ones are ignored.
+    /// The default style is sf::Text::Regular.
+    ///
+    /// \param style New style
+    ///
+    /// \see getStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStyle(Uint32 style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the global color of the text
+    ///
+    /// By default, the text's color is opaque white.
+    ///
+    /// \param color New color of the text
+    ///
+    /// \see getColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the text's string
+    ///
+    /// \return Text's string
+    ///
+    /// \see setString
+    ///
+    ////////////////////////////////////////////////////////////
+    const String& getString() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the text's font
+    ///
+    /// If the text has no font attached, a NULL pointer is returned.
+    ///
+    /// \return Pointer to the text's font
+    ///
+    /// \see setFont
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font* getFont() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size
+    ///
+    /// \return Size of the characters, in pixels
+    ///
+    /// \see setCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharacterSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the text's style
+    ///
+    /// \return Text's style
+    ///
+    /// \see setStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getStyle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global color of the text
+    ///
+    /// \return Global color of the text
+    ///
+    /// \see setColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of lines of the text
+    ///
+    /// \return Number of lines
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLineCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the vertical position of the top of a line
+    ///
+    /// This is useful to scroll a view to a given line. The
+    /// returned position is in local coordinates.
+    ///
+    /// \param line Index of the line
+    ///
+    /// \return Vertical position of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    float getLineTop(std::size_t line) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// The returned rectangle is the layout box of the text:
+    /// its width is the advance of the longest line, its height
+    /// is the number of lines times the line spacing. Computing
+    /// it requires the metrics of every character, so the result
+    /// is cached until the text changes.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the entity
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible lines of the text to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate the geometry of a chunk of lines
+    ///
+    /// \param chunk    Index of the chunk
+    /// \param vertices Vertex array to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    void buildChunk(std::size_t chunk, VertexArray& vertices) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard all the cached geometry
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<std::size_t, VertexArray> ChunkTable; ///< Table mapping a chunk index to its geometry
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    String                   m_string;           ///< String to display
+    const Font*              m_font;             ///< Font used to display the string
+    unsigned int             m_characterSize;    ///< Base size of characters, in pixels
+    Uint32                   m_style;            ///< Text style (see sf::Text::Style enum)
+    Color                    m_color;            ///< Text color
+    std::vector<std::size_t> m_lineStarts;       ///< Index of the first character of each line
+    mutable ChunkTable       m_chunks;           ///< Geometry of the chunks of lines which were recently visible
+    mutable FloatRect        m_bounds;           ///< Cached layout box of the text
+    mutable bool             m_boundsNeedUpdate; ///< Does the layout box need to be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_LARGETEXT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::LargeText
+/// \ingroup graphics
+///
+/// sf::LargeText displays strings that are too long to be
+/// handled efficiently by sf::Text, such as log files or
+/// documents of hundreds of thousands of characters.
+///
+/// Instead of generating and drawing the quads of all the
+/// characters, it only keeps the position of the line breaks,
+/// and generates the geometry of the lines which intersect
+/// the current view of the render target, by chunks of lines.
+/// Generated chunks are cached while they stay close to the
+/// view, so scrolling costs work and memory proportional to
+/// the visible part of the text only.
+///
+/// Lines are never wrapped nor clipped horizontally, and only
+/// the bold and italic styles are supported.
+///
+/// Usage example:
+/// \code
+/// sf::LargeText log(contents, font, 14);
+///
+/// // Scroll the view to line 1000
+/// sf::View view = window.getDefaultView();
+/// view.setCenter(view.getSize().x / 2, log.getLineTop(1000) + view.getSize().y / 2);
+/// window.setView(view);
+///
+/// // Only the visible lines are generated and drawn
+/// window.draw(log);
+/// \endcode
+///
+/// \see sf::Text, sf::Font
+///
+////////////////////////////////////////////////////////////
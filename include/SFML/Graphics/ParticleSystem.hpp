@@ -0,0 +1,515 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PARTICLESYSTEM_HPP
+#define SFML_PARTICLESYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Drawable system of many simple particles
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleSystem : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param capacity Maximum number of particles alive at the same time
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ParticleSystem(std::size_t capacity = 10000);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of particles alive at the same time
+    ///
+    /// Particles emitted while the system is full are discarded.
+    /// If the new capacity is lower than the current number of
+    /// particles, the extra particles are removed.
+    ///
+    /// \param capacity Maximum number of particles
+    ///
+    /// \see getCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCapacity(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of particles alive at the same time
+    ///
+    /// \return Maximum number of particles
+    ///
+    /// \see setCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of particles currently alive
+    ///
+    /// \return Number of particles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParticleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of the emitter
+    ///
+    /// New particles are emitted uniformly in a rectangle
+    /// centered on this position, in the local coordinates of
+    /// the particle system. Moving the emitter doesn't affect
+    /// the particles which are already alive, whereas changing
+    /// the transform of the particle system moves them all.
+    /// The default position is (0, 0).
+    ///
+    /// \param position New position of the emitter
+    ///
+    /// \see getEmitterPosition, setEmitterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEmitterPosition(const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of the emitter
+    ///
+    /// \return Position of the emitter
+    ///
+    /// \see setEmitterPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getEmitterPosition() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the area in which particles are emitted
+    ///
+    /// The default size is (0, 0): all the particles are
+    /// emitted at the position of the emitter.
+    ///
+    /// \param size New size of the emitter
+    ///
+    /// \see getEmitterSize, setEmitterPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEmitterSize(const Vector2f& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the area in which particles are emitted
+    ///
+    /// \return Size of the emitter
+    ///
+    /// \see setEmitterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getEmitterSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of particles emitted per second
+    ///
+    /// Particles are emitted continuously by update. The
+    /// default rate is 0: particles are only emitted by
+    /// explicit calls to emit.
+    ///
+    /// \param rate Number of particles emitted per second
+    ///
+    /// \see getEmissionRate, emit
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEmissionRate(float rate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of particles emitted per second
+    ///
+    /// \return Number of particles emitted per second
+    ///
+    /// \see setEmissionRate
+    ///
+    ////////////////////////////////////////////////////////////
+    float getEmissionRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the initial velocity of the particles
+    ///
+    /// The direction of each new particle is randomly chosen
+    /// within \a angleSpread degrees around the direction of
+    /// \a velocity, and its speed within \a speedSpread pixels
+    /// per second around the length of \a velocity.
+    /// The default velocity is (0, 0).
+    ///
+    /// \param velocity    Average initial velocity, in pixels per second
+    /// \param angleSpread Total angle of the directions of the particles, in degrees
+    /// \param speedSpread Maximum difference with the average speed, in pixels per second
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParticleVelocity(const Vector2f& velocity, float angleSpread = 0.f, float speedSpread = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the lifetime of the particles
+    ///
+    /// The lifetime of each new particle is randomly chosen
+    /// between \a minimum and \a maximum. The default lifetime
+    /// is one second.
+    ///
+    /// \param minimum Minimum lifetime of the particles
+    /// \param maximum Maximum lifetime of the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParticleLifetime(Time minimum, Time maximum);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the acceleration applied to all the particles
+    ///
+    /// The default gravity is (0, 0).
+    ///
+    /// \param acceleration Acceleration, in pixels per second squared
+    ///
+    /// \see getGravity
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGravity(const Vector2f& acceleration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the acceleration applied to all the particles
+    ///
+    /// \return Acceleration, in pixels per second squared
+    ///
+    /// \see setGravity
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getGravity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the drag slowing the particles down
+    ///
+    /// The speed of the particles decreases exponentially,
+    /// with \a drag as rate: a drag of 1 divides the speed by
+    /// e every second. The default drag is 0.
+    ///
+    /// \param drag Drag coefficient, per second
+    ///
+    /// \see getDrag
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDrag(float drag);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the drag slowing the particles down
+    ///
+    /// \return Drag coefficient, per second
+    ///
+    /// \see setDrag
+    ///
+    ////////////////////////////////////////////////////////////
+    float getDrag() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the color of the particles fade between two colors
+    ///
+    /// Particles have the \a start color when they are emitted,
+    /// and the \a end color at the end of their lifetime.
+    /// The default ramp is plain white.
+    ///
+    /// \param start Color of the new particles
+    /// \param end   Color of the particles about to die
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColorRamp(const Color& start, const Color& end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the color of the particles fade through several colors
+    ///
+    /// The colors are evenly distributed over the lifetime of
+    /// the particles, the first one being used for the new
+    /// particles and the last one for the particles about to
+    /// die. The ramp is sampled into a table of 256 colors.
+    ///
+    /// \param colors Colors of the ramp, in order (at least one)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColorRamp(const std::vector<Color>& colors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the particles
+    ///
+    /// Particles with a size are drawn as squares centered on
+    /// their position, which can be textured. Particles with a
+    /// size of 0 are drawn as single points, which is much
+    /// faster for very large systems; this is the default.
+    ///
+    /// \param size Width and height of the particles, or 0 to draw points
+    ///
+    /// \see getParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParticleSize(float size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the particles
+    ///
+    /// \return Width and height of the particles
+    ///
+    /// \see setParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    float getParticleSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture of the particles
+    ///
+    /// The texture is modulated by the color of each particle.
+    /// If \a resetRect is true, or if the texture rect was not
+    /// set before, the texture rect is adjusted to the size of
+    /// the new texture. The texture must stay alive as long as
+    /// the particle system uses it.
+    ///
+    /// \param texture   New texture, or NULL to disable texturing
+    /// \param resetRect Should the texture rect be reset to the size of the new texture?
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sub-rectangle of the texture mapped on each particle
+    ///
+    /// \param rect Rectangle defining the region of the texture to display
+    ///
+    /// \see getTextureRect, setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the particles
+    ///
+    /// \return Pointer to the texture, or NULL if none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture mapped on each particle
+    ///
+    /// \return Texture rectangle of the particles
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads used to update the particles
+    ///
+    /// Large systems are split into contiguous ranges of
+    /// particles which are updated in parallel. Small systems
+    /// are always updated by the calling thread only, since
+    /// the cost of the threads would outweigh the gain.
+    /// The default is 1: no additional thread is used.
+    ///
+    /// \param count Maximum number of threads, including the calling thread
+    ///
+    /// \see getThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads used to update the particles
+    ///
+    /// \return Maximum number of threads
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Emit new particles immediately
+    ///
+    /// The new particles appear on screen after the next call
+    /// to update.
+    ///
+    /// \param count Number of particles to emit
+    ///
+    /// \see setEmissionRate
+    ///
+    ////////////////////////////////////////////////////////////
+    void emit(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the simulation
+    ///
+    /// This function moves and ages the particles, removes the
+    /// ones which reached the end of their lifetime, emits new
+    /// ones according to the emission rate, and prepares the
+    /// geometry of all the particles for drawing.
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the particle system to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the vertex buffer and write the texture coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateLayout();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the position and color of the particles to the vertex buffer
+    ///
+    /// \param first Index of the first particle to write, the following ones are written too
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateVertices(std::size_t first = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate a pseudo-random number between 0 and 1
+    ///
+    /// \return Random number in [0, 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    float random();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<float>  m_positionsX;      ///< X coordinate of the particles
+    std::vector<float>  m_positionsY;      ///< Y coordinate of the particles
+    std::vector<float>  m_velocitiesX;     ///< X component of the velocity of the particles
+    std::vector<float>  m_velocitiesY;     ///< Y component of the velocity of the particles
+    std::vector<float>  m_ages;            ///< Age of the particles, relative to their lifetime (0 to 1)
+    std::vector<float>  m_ageRates;        ///< Inverse of the lifetime of the particles, in 1 / seconds
+    std::size_t         m_particleCount;   ///< Number of particles alive
+    std::vector<Vertex> m_vertices;        ///< Vertex buffer, rewritten by each update
+    std::vector<Uint16> m_indices;         ///< Indices of the triangles of one batch of squares
+    std::size_t         m_drawCount;       ///< Number of particles written to the vertex buffer
+    Vector2f            m_emitterPosition; ///< Center of the emitter
+    Vector2f            m_emitterSize;     ///< Size of the emitter
+    float               m_emissionRate;    ///< Particles emitted per second
+    float               m_emissionDebt;    ///< Fraction of particle not emitted yet
+    float               m_speed;           ///< Average initial speed of the particles
+    float               m_speedSpread;     ///< Maximum difference with the average initial speed
+    float               m_angle;           ///< Average initial direction of the particles, in radians
+    float               m_angleSpread;     ///< Total angle of the initial directions, in radians
+    float               m_minLifetime;     ///< Minimum lifetime of the particles, in seconds
+    float               m_maxLifetime;     ///< Maximum lifetime of the particles, in seconds
+    Vector2f            m_gravity;         ///< Acceleration applied to the particles
+    float               m_drag;            ///< Drag coefficient slowing the particles down
+    std::vector<Color>  m_colorRamp;       ///< Table of the colors of the particles over their lifetime
+    float               m_particleSize;    ///< Size of the particles, 0 for points
+    const Texture*      m_texture;         ///< Texture of the particles
+    IntRect             m_textureRect;     ///< Rectangle defining the area of the texture to display
+    unsigned int        m_threadCount;     ///< Maximum number of threads used to update the particles
+    Uint32              m_random;          ///< State of the random number generator
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLESYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleSystem
+/// \ingroup graphics
+///
+/// sf::ParticleSystem simulates and draws large numbers of
+/// short-lived particles, such as sparks, smoke or rain.
+///
+/// Each particle has a position, a velocity, and an age
+/// relative to its lifetime which defines its color through
+/// a color ramp. Particles are emitted by a rectangular
+/// emitter, accelerated by a global gravity, slowed down by
+/// a drag, and removed when they reach the end of their
+/// lifetime.
+///
+/// The state of the particles is stored as separate arrays
+/// of floats, which the compiler can process with vector
+/// instructions, and can be updated by several threads for
+/// very large systems (see setThreadCount). The geometry of
+/// the particles is rewritten in place by each update and
+/// drawn directly from the vertex buffer, without any
+/// intermediate copy.
+///
+/// Usage example:
+/// \code
+/// sf::ParticleSystem fire(100000);
+/// fire.setEmitterPosition(sf::Vector2f(400, 500));
+/// fire.setEmitterSize(sf::Vector2f(50, 0));
+/// fire.setEmissionRate(50000);
+/// fire.setParticleVelocity(sf::Vector2f(0, -200), 30, 50);
+/// fire.setParticleLifetime(sf::seconds(1), sf::seconds(2));
+/// fire.setColorRamp(sf::Color::Yellow, sf::Color(255, 0, 0, 0));
+///
+/// sf::Clock clock;
+/// while (window.isOpen())
+/// {
+///     ...
+///     fire.update(clock.restart());
+///
+///     window.clear();
+///     window.draw(fire);
+///     window.display();
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
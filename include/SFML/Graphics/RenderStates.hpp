@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/Transform.hpp>
 
 
@@ -56,6 +57,7 @@ public:
     /// \li the identity transform
     /// \li a null texture
     /// \li a null shader
+    /// \li a disabled scissor rectangle (no clipping)
     ///
     ////////////////////////////////////////////////////////////
     RenderStates();
@@ -92,6 +94,17 @@ public:
     ////////////////////////////////////////////////////////////
     RenderStates(const Shader* theShader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a default set of render states with a custom scissor rectangle
+    ///
+    /// The scissor test is enabled; if \a theScissor is empty,
+    /// nothing is drawn with these states.
+    ///
+    /// \param theScissor Scissor rectangle to use, in target pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStates(const IntRect& theScissor);
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a set of render states with all its attributes
     ///
@@ -104,6 +117,23 @@ public:
     RenderStates(const BlendMode& theBlendMode, const Transform& theTransform,
                  const Texture* theTexture, const Shader* theShader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a set of render states with all its attributes and a scissor rectangle
+    ///
+    /// The scissor test is enabled; if \a theScissor is empty,
+    /// nothing is drawn with these states.
+    ///
+    /// \param theBlendMode Blend mode to use
+    /// \param theTransform Transform to use
+    /// \param theTexture   Texture to use
+    /// \param theShader    Shader to use
+    /// \param theScissor   Scissor rectangle to use, in target pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStates(const BlendMode& theBlendMode, const Transform& theTransform,
+                 const Texture* theTexture, const Shader* theShader,
+                 const IntRect& theScissor);
+
     ////////////////////////////////////////////////////////////
     // Static member data
     ////////////////////////////////////////////////////////////
@@ -112,10 +142,12 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    BlendMode      blendMode; ///< Blending mode
-    Transform      transform; ///< Transform
-    const Texture* texture;   ///< Texture
-    const Shader*  shader;    ///< Shader
+    BlendMode      blendMode;      ///< Blending mode
+    Transform      transform;      ///< Transform
+    const Texture* texture;        ///< Texture
+    const Shader*  shader;         ///< Shader
+    IntRect        scissor;        ///< Scissor rectangle, in target pixels
+    bool           scissorEnabled; ///< Is drawing restricted to the scissor rectangle?
 };
 
 } // namespace sf
@@ -128,12 +160,13 @@ public:
 /// \class sf::RenderStates
 /// \ingroup graphics
 ///
-/// There are four global states that can be applied to
+/// There are five global states that can be applied to
 /// the drawn objects:
 /// \li the blend mode: how pixels of the object are blended with the background
 /// \li the transform: how the object is positioned/rotated/scaled
 /// \li the texture: what image is mapped to the object
 /// \li the shader: what custom effect is applied to the object
+/// \li the scissor: which rectangle of the target can be modified
 ///
 /// High-level objects such as sprites or text force some of
 /// these states when they are drawn. For example, a sprite
@@ -169,6 +202,30 @@ public:
 /// current transform with its own transform. A sprite will
 /// set its texture. Etc.
 ///
+/// The scissor rectangle is expressed in pixels of the render
+/// target, with the origin at its top-left corner; it is not
+/// affected by the current view nor by the transform. Anything
+/// drawn outside of it is discarded, which is useful to clip
+/// the contents of a scrolling panel, for example. Because it
+/// is part of the states, it travels with the other states
+/// through batches and nested drawables. It doesn't
+/// affect RenderTarget::clear, which always clears the whole
+/// target.
+///
+/// The rectangle is only used when scissorEnabled is true.
+/// An enabled but empty rectangle discards everything, so that
+/// nested clip rectangles whose intersection is empty (a panel
+/// scrolled out of view) draw nothing rather than everything.
+/// \code
+/// sf::RenderStates states;
+/// states.scissor = sf::IntRect(10, 10, 200, 100);
+/// states.scissorEnabled = true;
+/// window.draw(text, states);
+///
+/// // Or, equivalently
+/// window.draw(text, sf::IntRect(10, 10, 200, 100));
+/// \endcode
+///
 /// \see sf::RenderTarget, sf::Drawable
 ///
 ////////////////////////////////////////////////////////////
@@ -37,12 +37,16 @@
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
 
 
 namespace sf
 {
+class CompactVertexArray;
 class Drawable;
+class IndexArray;
+class VertexArray;
 
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
@@ -67,7 +71,7 @@ public:
     /// \param color Fill color to use to clear the render target
     ///
     ////////////////////////////////////////////////////////////
-    void clear(const Color& color = Color(0, 0, 0, 255));
+    virtual void clear(const Color& color = Color(0, 0, 0, 255));
 
     ////////////////////////////////////////////////////////////
     /// \brief Change the current active view
@@ -247,6 +251,102 @@ public:
     void draw(const Vertex* vertices, std::size_t vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices and 16-bit indices
+    ///
+    /// The primitives are made of the vertices referred to by
+    /// the indices, in order; vertices shared by several
+    /// primitives can thus be stored only once.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices and 32-bit indices
+    ///
+    /// 32-bit indices are not supported on OpenGL ES platforms.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the primitives of a vertex array in the order given by an index array
+    ///
+    /// \param vertices Vertex array defining the vertices and the type of primitives
+    /// \param indices  Index array referring to the vertices of \a vertices
+    /// \param states   Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexArray& vertices, const IndexArray& indices, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of compact vertices
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const CompactVertex* vertices, std::size_t vertexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of compact vertices and 16-bit indices
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const CompactVertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of compact vertices and 32-bit indices
+    ///
+    /// 32-bit indices are not supported on OpenGL ES platforms.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const CompactVertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the primitives of a compact vertex array in the order given by an index array
+    ///
+    /// \param vertices Compact vertex array defining the vertices and the type of primitives
+    /// \param indices  Index array referring to the vertices of \a vertices
+    /// \param states   Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const CompactVertexArray& vertices, const IndexArray& indices, const RenderStates& states = RenderStates::Default);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -340,8 +440,51 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict all the following clears and draws to a rectangle
+    ///
+    /// The area is combined with the scissor rectangle of the
+    /// render states. Derived classes use it to update only the
+    /// parts of their contents that changed. An empty area
+    /// discards everything until resetClipArea() is called.
+    ///
+    /// \param area Clipping rectangle, in target pixels
+    ///
+    /// \see resetClipArea
+    ///
+    ////////////////////////////////////////////////////////////
+    void setClipArea(const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Let the following clears and draws affect the whole target again
+    ///
+    /// \see setClipArea
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetClipArea();
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives, with or without indices
+    ///
+    /// All the draw functions end up calling this function. The
+    /// default implementation renders with OpenGL; targets which
+    /// render by other means override it.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param compact     Are the vertices sf::CompactVertex instead of sf::Vertex?
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param indices     Pointer to the indices, NULL to draw the vertices in order
+    /// \param indexCount  Number of indices in the array
+    /// \param indexSize   Size of an index, in bytes (2 or 4)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawPrimitives(const void* vertices, std::size_t vertexCount, bool compact, PrimitiveType type, const RenderStates& states,
+                                const void* indices, std::size_t indexCount, std::size_t indexSize);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -364,6 +507,15 @@ private:
     ////////////////////////////////////////////////////////////
     void applyTransform(const Transform& transform);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply a new scissor rectangle
+    ///
+    /// \param enabled Enable or disable the scissor test
+    /// \param scissor Scissor rectangle to apply, in target pixels (must not be empty if enabled)
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyScissor(bool enabled, const IntRect& scissor);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new texture
     ///
@@ -402,11 +554,13 @@ private:
     {
         enum {VertexCacheSize = 4};
 
-        bool      glStatesSet;    ///< Are our internal GL states set yet?
-        bool      viewChanged;    ///< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  ///< Cached blending mode
-        Uint64    lastTextureId;  ///< Cached texture
-        bool      useVertexCache; ///< Did we previously use the vertex cache?
+        bool      glStatesSet;        ///< Are our internal GL states set yet?
+        bool      viewChanged;        ///< Has the current view changed since last draw?
+        BlendMode lastBlendMode;      ///< Cached blending mode
+        Uint64    lastTextureId;      ///< Cached texture
+        bool      lastScissorEnabled; ///< Cached scissor test state
+        IntRect   lastScissor;        ///< Cached scissor rectangle
+        bool      useVertexCache;     ///< Did we previously use the vertex cache?
         Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
     };
 
@@ -416,6 +570,8 @@ private:
     View        m_defaultView; ///< Default view
     View        m_view;        ///< Current view
     StatesCache m_cache;       ///< Render states cache
+    bool        m_clipping;    ///< Are clears and draws restricted to m_clipArea?
+    IntRect     m_clipArea;    ///< Area outside of which nothing is cleared nor drawn
 };
 
 } // namespace sf
@@ -33,6 +33,7 @@
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Window/Window.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -128,6 +129,74 @@ public:
     ////////////////////////////////////////////////////////////
     Image capture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable damage tracking
+    ///
+    /// When damage tracking is enabled, only the regions reported
+    /// with addDirtyRegion are cleared, drawn and presented;
+    /// everything outside of them is left untouched. The next
+    /// frame is always redrawn entirely.
+    /// Damage tracking is disabled by default.
+    ///
+    /// \param enabled True to enable damage tracking, false to disable it
+    ///
+    /// \see isDamageTrackingEnabled, addDirtyRegion
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDamageTrackingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether damage tracking is enabled or not
+    ///
+    /// \return True if damage tracking is enabled
+    ///
+    /// \see setDamageTrackingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDamageTrackingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a region of the window as changed in the current frame
+    ///
+    /// Dirty regions must be reported before the frame is
+    /// cleared and drawn, since clearing and drawing are
+    /// restricted to them. This function has no effect if
+    /// damage tracking is disabled.
+    ///
+    /// \param region Region that changed, in pixels
+    ///
+    /// \see setDamageTrackingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void addDirtyRegion(const IntRect& region);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark an area of the world as changed in the current frame
+    ///
+    /// The area is converted to pixels with the current view;
+    /// it is typically the global bounds of a drawable, before
+    /// and after it moves or changes.
+    ///
+    /// \param area Area that changed, in world coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    void addDirtyRegion(const FloatRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the region that will be redrawn in the current frame
+    ///
+    /// This is the union of the dirty regions of the current
+    /// frame and of the previous frames that are missing from
+    /// the back buffer. It covers the whole window if damage
+    /// tracking is disabled, or if the platform can't tell
+    /// what the back buffer contains. If it is empty, nothing
+    /// needs to be drawn in the current frame.
+    ///
+    /// \return Region of the window that will be redrawn, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getRedrawRegion() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -149,6 +218,17 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called by display() to present the rendered frame
+    ///
+    /// If damage tracking is enabled, only the dirty regions
+    /// are presented when the platform supports it, and
+    /// nothing is presented if nothing changed. Otherwise the
+    /// whole frame is presented.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -160,6 +240,27 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     virtual bool activate(bool active);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict clearing and drawing to the current redraw region
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateClipArea();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the damage history and redraw the next frame entirely
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateDamage();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    bool                 m_damageTracking; ///< Is damage tracking enabled?
+    bool                 m_fullRedraw;     ///< Must the current frame be redrawn entirely?
+    unsigned int         m_bufferAge;      ///< Age of the back buffer, 0 if unknown
+    IntRect              m_damage;         ///< Region that changed in the current frame
+    std::vector<IntRect> m_damageHistory;  ///< Regions that changed in the previous frames, most recent first
 };
 
 } // namespace sf
@@ -218,6 +319,36 @@ private:
 /// }
 /// \endcode
 ///
+/// Applications which only change small parts of a large window
+/// from one frame to the next (clocks, gauges, ...) can enable
+/// damage tracking. Regions that change are reported before
+/// drawing, and the window restricts clearing, drawing and
+/// presenting to them with scissoring. Where the platform tells
+/// the age of the back buffer (GLX_EXT_buffer_age, EGL_EXT_buffer_age),
+/// only these regions are redrawn; elsewhere the whole frame is
+/// redrawn. Regions are presented with EGL swap-with-damage
+/// when available.
+///
+/// \code
+/// window.setDamageTrackingEnabled(true);
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///
+///     // Report both the old and the new bounds of what changes
+///     window.addDirtyRegion(clock.getGlobalBounds());
+///     clock.setString(getTime());
+///     window.addDirtyRegion(clock.getGlobalBounds());
+///
+///     // Draw the whole scene as usual, only the dirty regions are updated
+///     window.clear();
+///     window.draw(background);
+///     window.draw(clock);
+///     window.display();
+/// }
+/// \endcode
+///
 /// Like sf::Window, sf::RenderWindow is still able to render direct
 /// OpenGL stuff. It is even possible to mix together OpenGL calls
 /// and regular SFML drawing commands.
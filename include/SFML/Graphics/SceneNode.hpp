@@ -0,0 +1,357 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SCENENODE_HPP
+#define SFML_SCENENODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Node of a retained hierarchy of transformable objects
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SceneNode : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty node, with no parent, no children and
+    /// no content.
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The node is detached from its parent, and its children
+    /// become roots of their own hierarchy.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SceneNode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attach a child to the node
+    ///
+    /// The child is detached from its previous parent, if any,
+    /// and is drawn after the content of this node and after
+    /// its previously attached children.
+    /// The node doesn't take ownership of the child, which must
+    /// stay alive as long as it is attached.
+    ///
+    /// A node cannot be attached to itself or to one of its
+    /// descendants; an error is printed in this case.
+    ///
+    /// \param child Node to attach
+    ///
+    /// \see detachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachChild(SceneNode& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Detach a child from the node
+    ///
+    /// This function does nothing if \a child is not a child
+    /// of this node.
+    ///
+    /// \param child Node to detach
+    ///
+    /// \see attachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachChild(SceneNode& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of the node
+    ///
+    /// \return Pointer to the parent node, or NULL if the node is a root
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode* getParent() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of children of the node
+    ///
+    /// \return Number of children
+    ///
+    /// \see getChild
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChildCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a child of the node
+    ///
+    /// Children are ordered in the order they were attached,
+    /// which is also the order in which they are drawn.
+    /// The behaviour is undefined if \a index is out of range.
+    ///
+    /// \param index Index of the child to get
+    ///
+    /// \return Reference to the child
+    ///
+    /// \see getChildCount
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode& getChild(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the drawable content of the node
+    ///
+    /// The content is drawn with the world transform of the
+    /// node. \a bounds is the bounding rectangle of the content
+    /// in the local coordinates of the node, which is used to
+    /// cull the node when it is outside the view; for a sprite
+    /// or a shape, it is the result of getGlobalBounds().
+    /// The node doesn't copy the content, which must stay alive
+    /// as long as it is used by the node.
+    ///
+    /// \param content Drawable to draw at the node, or NULL for none
+    /// \param bounds  Bounding rectangle of the content, in local coordinates
+    ///
+    /// \see getContent, invalidateBounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void setContent(const Drawable* content, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the drawable content of the node
+    ///
+    /// \return Pointer to the content, or NULL if the node has none
+    ///
+    /// \see setContent
+    ///
+    ////////////////////////////////////////////////////////////
+    const Drawable* getContent() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify the node that the bounds of its content have changed
+    ///
+    /// This function must be called by derived classes which
+    /// override getContentBounds, whenever the returned
+    /// rectangle changes. Only this node and its ancestors have
+    /// their world bounds recomputed.
+    ///
+    /// \see getContentBounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateBounds();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the world transform of the node
+    ///
+    /// The world transform combines the transforms of all the
+    /// ancestors of the node with its own transform. It is
+    /// cached, and recomputed only when the node or one of its
+    /// ancestors has been moved, rotated, scaled or reparented.
+    ///
+    /// \return World transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    const Transform& getWorldTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the world bounding rectangle of the node
+    ///
+    /// The returned rectangle encloses the content of the node
+    /// and of all its descendants, in the coordinate system of
+    /// the root of the hierarchy. It is cached, and recomputed
+    /// only when something changed in the subtree.
+    /// A subtree without any content has empty bounds.
+    ///
+    /// \return World bounding rectangle of the subtree
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect& getWorldBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the nodes of the subtree which intersect an area
+    ///
+    /// The nodes whose content intersects \a area are appended
+    /// to \a nodes, in drawing order; subtrees which are
+    /// entirely outside the area are skipped without being
+    /// traversed. This is the culling step performed when
+    /// drawing the node, which can be used to feed the visible
+    /// nodes to a custom renderer or to a batch instead.
+    ///
+    /// \param area  Area to test, in the coordinate system of the root
+    /// \param nodes Array to which the intersecting nodes are appended
+    ///
+    ////////////////////////////////////////////////////////////
+    void findVisibleNodes(const FloatRect& area, std::vector<const SceneNode*>& nodes) const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the content of the node
+    ///
+    /// The default implementation draws the drawable set with
+    /// setContent. Derived classes can override it to draw
+    /// anything else, in which case they must also override
+    /// getContentBounds so that the node is not culled.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states, including the world transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawContent(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the content of the node
+    ///
+    /// The default implementation returns the rectangle passed
+    /// to setContent. An empty rectangle means that the node
+    /// has nothing to draw.
+    ///
+    /// \return Bounding rectangle of the content, in local coordinates
+    ///
+    /// \see invalidateBounds
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual FloatRect getContentBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the node and its children to a render target
+    ///
+    /// Only the nodes which intersect the view of the target
+    /// are drawn.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible part of the subtree
+    ///
+    /// \param target Render target to draw to
+    /// \param states Render states of the root of the hierarchy
+    /// \param area   Visible area, in the coordinate system of the root
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawSubtree(RenderTarget& target, const RenderStates& states, const FloatRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Invalidate the cached world data when the transform changes
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onTransformChange();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the world transforms of the subtree as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateWorldTransforms();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the world bounds of the node and its ancestors as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateWorldBounds();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the world bounds are updated
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureBoundsUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SceneNode*              m_parent;                   ///< Parent of the node, NULL for a root
+    std::vector<SceneNode*> m_children;                 ///< Children of the node, in drawing order
+    const Drawable*         m_content;                  ///< Drawable drawn at the node
+    FloatRect               m_contentBounds;            ///< Bounding rectangle of the content, in local coordinates
+    mutable Transform       m_worldTransform;           ///< Combined transform of the node and its ancestors
+    mutable bool            m_worldTransformNeedUpdate; ///< Does the world transform need to be recomputed?
+    mutable FloatRect       m_contentWorldBounds;       ///< Bounding rectangle of the content, in world coordinates
+    mutable FloatRect       m_worldBounds;              ///< Bounding rectangle of the subtree, in world coordinates
+    mutable bool            m_worldBoundsNeedUpdate;    ///< Do the world bounds need to be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SCENENODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SceneNode
+/// \ingroup graphics
+///
+/// sf::SceneNode organizes transformable objects in a tree:
+/// the transform of a node is relative to its parent, so
+/// moving a node moves its whole subtree.
+///
+/// Unlike hierarchies built by hand, by combining transforms
+/// in each draw() function, nodes keep their world transform
+/// and world bounds cached. Changing the position, rotation,
+/// scale or origin of a node only marks its subtree as
+/// outdated, so static parts of the scene cost nothing to
+/// update, and subtrees that are outside the view are culled
+/// without being traversed when the hierarchy is drawn.
+///
+/// A node can draw any drawable through setContent, or draw
+/// custom geometry by overriding drawContent and
+/// getContentBounds. Nodes don't own their children nor
+/// their content.
+///
+/// Usage example:
+/// \code
+/// sf::SceneNode world, ship, turret;
+/// world.attachChild(ship);
+/// ship.attachChild(turret);
+///
+/// ship.setContent(&shipSprite, shipSprite.getGlobalBounds());
+/// turret.setContent(&turretSprite, turretSprite.getGlobalBounds());
+/// turret.setPosition(20, 0);
+///
+/// // Rotating the ship also rotates the turret
+/// ship.rotate(5);
+///
+/// // Only the nodes which intersect the view are drawn
+/// window.draw(world);
+/// \endcode
+///
+/// \see sf::Transformable, sf::Drawable
+///
+////////////////////////////////////////////////////////////
@@ -267,6 +267,8 @@ protected:
 
 private:
 
+    friend class ShapeBatch;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the shape to a render target
     ///
@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SHAPEBATCH_HPP
+#define SFML_SHAPEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/IndexArray.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Shape;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Set of shapes drawn together with a single draw call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ShapeBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch, without texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    ShapeBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a shape to the batch
+    ///
+    /// The batch keeps a pointer to \a shape, which must
+    /// therefore remain alive as long as it is in the batch.
+    /// Shapes are drawn in the order in which they are added.
+    ///
+    /// \param shape Shape to add
+    ///
+    /// \return Index of the shape in the batch
+    ///
+    /// \see invalidate
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t add(const Shape& shape);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of shapes in the batch
+    ///
+    /// \return Number of shapes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getShapeCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the shapes from the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the geometry of a shape as outdated
+    ///
+    /// The batch doesn't track the changes made to its shapes:
+    /// this function must be called after modifying a shape
+    /// (its points, colors, outline or transform) so that its
+    /// geometry is rebuilt the next time the batch is drawn.
+    /// Only the marked shapes are tessellated again.
+    ///
+    /// \param index Index of the modified shape, as returned by add
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the geometry of all the shapes as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture used to draw the batch
+    ///
+    /// All the shapes of a batch are drawn with the same texture:
+    /// the texture of each shape is ignored, only its texture
+    /// rect is used. Pass NULL to draw untextured shapes.
+    ///
+    /// \param texture New texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture used to draw the batch
+    ///
+    /// \return Pointer to the texture, or NULL if there's none
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of all the shapes of the batch
+    ///
+    /// \return Bounding rectangle of the shapes, in the coordinates of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the geometry of the marked shapes is updated
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the transformed vertices of a shape, and optionally its indices
+    ///
+    /// \param shape       Shape to tessellate
+    /// \param firstVertex Position of the shape's first vertex in the vertex array
+    /// \param addIndices  Append the indices of the shape's triangles to the index array?
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeShape(const Shape& shape, std::size_t firstVertex, bool addIndices) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a shape of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Item
+    {
+        Item(const Shape* itemShape) : shape(itemShape), firstVertex(0), fillCount(0), outlineCount(0), firstIndex(0), needUpdate(true) {}
+
+        const Shape* shape;        ///< Shape to draw
+        std::size_t  firstVertex;  ///< Position of the shape's first vertex in the vertex array
+        std::size_t  fillCount;    ///< Number of vertices of the shape's fill
+        std::size_t  outlineCount; ///< Number of vertices of the shape's outline (0 if it has no outline)
+        std::size_t  firstIndex;   ///< Position of the shape's first index in the index array
+        bool         needUpdate;   ///< Must the shape's geometry be rebuilt?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable std::vector<Item> m_items;              ///< Shapes of the batch, in drawing order
+    const Texture*            m_texture;            ///< Texture used to draw all the shapes
+    mutable VertexArray       m_vertices;           ///< Transformed vertices of all the shapes
+    mutable IndexArray        m_indices;            ///< Triangle list made of the vertices of all the shapes
+    mutable bool              m_geometryNeedUpdate; ///< Is any shape marked for update?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHAPEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ShapeBatch
+/// \ingroup graphics
+///
+/// Each sf::Shape is drawn with two draw calls, one for its
+/// fill and one for its outline, which becomes a bottleneck
+/// when thousands of shapes are displayed. sf::ShapeBatch
+/// tessellates a set of shapes, fills and outlines, into a
+/// single list of indexed triangles with the transforms of
+/// the shapes already applied, and draws it in one call. The
+/// result is the same as drawing the shapes one after the
+/// other.
+///
+/// The batch refers to the shapes, it doesn't copy them;
+/// it caches their geometry, which must be explicitly marked
+/// as outdated with invalidate() when a shape changes.
+///
+/// All the shapes are drawn with the texture of the batch.
+/// Since the outlines are part of the same draw call, they
+/// use the texture too, with texture coordinates (0, 0): in
+/// a textured batch, the outlines are therefore modulated by
+/// the top-left pixel of the texture.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::CircleShape> circles(1000, sf::CircleShape(5));
+/// sf::ShapeBatch batch;
+/// for (std::size_t i = 0; i < circles.size(); ++i)
+/// {
+///     circles[i].setPosition(i % 40 * 20.f, i / 40 * 20.f);
+///     batch.add(circles[i]);
+/// }
+///
+/// // move a circle
+/// circles[10].move(5, 0);
+/// batch.invalidate(10);
+///
+/// window.draw(batch);
+/// \endcode
+///
+/// \see sf::Shape, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
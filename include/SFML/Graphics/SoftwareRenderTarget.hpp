@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOFTWARERENDERTARGET_HPP
+#define SFML_SOFTWARERENDERTARGET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SoftwareRasterizer;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Target for 2D rendering into an image, without
+///        using the graphics card
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SoftwareRenderTarget : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs an empty, invalid render target. You must
+    /// call create to have a valid render target.
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    SoftwareRenderTarget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SoftwareRenderTarget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render target
+    ///
+    /// Before calling this function, the render target is in
+    /// an invalid state, thus it is mandatory to call it before
+    /// doing anything with the render target. Its contents are
+    /// black and opaque after creation.
+    ///
+    /// \param width  Width of the render target
+    /// \param height Height of the render target
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads used to rasterize
+    ///
+    /// The target is split into tiles of 64x64 pixels, which
+    /// are distributed among the threads. A single thread
+    /// is used for small amounts of geometry, regardless of
+    /// this setting.
+    /// The default is 1 (no additional thread).
+    ///
+    /// \param count Maximum number of threads
+    ///
+    /// \see getThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads used to rasterize
+    ///
+    /// \return Maximum number of threads
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the entire target with a single color
+    ///
+    /// \param color Fill color to use to clear the render target
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void clear(const Color& color = Color(0, 0, 0, 255));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the contents of the target image
+    ///
+    /// Drawing only records the geometry; this function
+    /// rasterizes everything that has been drawn since the
+    /// last call and copies the result to the target image.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the rendering region of the target
+    ///
+    /// The returned value is the size that you passed to
+    /// the create function.
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to the target image
+    ///
+    /// The image is updated by display.
+    ///
+    /// \return Const reference to the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getImage() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the target for rendering
+    ///
+    /// There's no OpenGL context behind this target, so this
+    /// always fails and the OpenGL code of the base class is
+    /// never run.
+    ///
+    /// \param active True to make the target active, false to deactivate it
+    ///
+    /// \return Always false
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool activate(bool active);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives, with or without indices
+    ///
+    /// The primitives are transformed, assembled into triangles
+    /// and queued for the rasterizer.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param compact     Are the vertices sf::CompactVertex instead of sf::Vertex?
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param indices     Pointer to the indices, or NULL to draw the vertices in order
+    /// \param indexCount  Number of indices in the array
+    /// \param indexSize   Size of an index, in bytes (2 or 4)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawPrimitives(const void* vertices, std::size_t vertexCount, bool compact, PrimitiveType type, const RenderStates& states,
+                                const void* indices, std::size_t indexCount, std::size_t indexSize);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::SoftwareRasterizer* m_rasterizer;  ///< Triangle rasterizer owning the color buffer
+    Image                     m_image;       ///< Target image
+    unsigned int              m_threadCount; ///< Maximum number of threads used by the rasterizer
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOFTWARERENDERTARGET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoftwareRenderTarget
+/// \ingroup graphics
+///
+/// sf::SoftwareRenderTarget implements the same 2D drawing
+/// functions as sf::RenderWindow and sf::RenderTexture (see
+/// their base class sf::RenderTarget for more details), but
+/// the primitives are rasterized by the CPU, and the result
+/// is stored in an sf::Image.
+///
+/// It is meant for machines without a graphics card, such
+/// as servers generating previews, and as a reference to
+/// compare the output of the other render targets with.
+///
+/// Transforms, views and blend modes are supported; shaders
+/// are ignored, and OpenGL calls have no effect on this
+/// target. Lines and points are drawn as 1 pixel wide quads,
+/// which may slightly differ from what the graphics card does.
+///
+/// Shapes and vertex arrays don't need OpenGL at all. Textures
+/// however live in video memory: a texture is downloaded once
+/// when it's first drawn (and again when it's modified), which
+/// requires an OpenGL context in the thread at that time.
+///
+/// Drawing is deferred: the geometry is recorded by the draw
+/// functions, and rasterized when display is called. The
+/// target is split into tiles which can be rasterized in
+/// parallel by several threads (see setThreadCount).
+///
+/// Usage example:
+///
+/// \code
+/// sf::SoftwareRenderTarget target;
+/// if (!target.create(256, 256))
+///     return -1;
+///
+/// target.setThreadCount(4);
+///
+/// target.clear(sf::Color::White);
+/// target.draw(shape);  // shape is a sf::Shape
+/// target.draw(text);   // text is a sf::Text
+/// target.display();
+///
+/// target.getImage().saveToFile("thumbnail.png");
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::RenderTexture, sf::Image
+///
+////////////////////////////////////////////////////////////
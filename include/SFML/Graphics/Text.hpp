@@ -35,6 +35,7 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/String.hpp>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -170,6 +171,34 @@ public:
     ////////////////////////////////////////////////////////////
     void setColor(const Color& color);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable distance field rendering
+    ///
+    /// By default, the glyphs of a text are rasterized by its font
+    /// for its exact character size, which keeps small texts sharp
+    /// but requires a new texture and new glyphs for every size.
+    ///
+    /// In distance field mode, the text uses the glyphs returned
+    /// by Font::getDistanceFieldGlyph, which are rasterized once
+    /// and scaled, and draws them with a built-in shader. This is
+    /// well suited to texts that are scaled or zoomed a lot; the
+    /// bold style is obtained by moving the shader's threshold
+    /// rather than emboldening the outlines.
+    ///
+    /// This mode requires shaders (see Shader::isAvailable) and
+    /// a scalable font; when shaders are not available, the text
+    /// is drawn normally. If a shader is given in the render states
+    /// when drawing the text, it replaces the built-in one.
+    ///
+    /// The default is disabled.
+    ///
+    /// \param enabled True to enable distance field rendering, false to disable it
+    ///
+    /// \see isDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceFieldEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the text's string
     ///
@@ -233,6 +262,16 @@ public:
     ////////////////////////////////////////////////////////////
     const Color& getColor() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether distance field rendering is enabled
+    ///
+    /// \return True if distance field rendering is enabled, false if not
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceFieldEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the position of the \a index-th character
     ///
@@ -280,6 +319,32 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the layout of a line of the text
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        Line(std::size_t lineFirstChar, std::size_t lineFirstVertex, float lineY) :
+        firstChar  (lineFirstChar),
+        firstVertex(lineFirstVertex),
+        y          (lineY),
+        minX       (std::numeric_limits<float>::max()),
+        minY       (std::numeric_limits<float>::max()),
+        maxX       (-std::numeric_limits<float>::max()),
+        maxY       (-std::numeric_limits<float>::max())
+        {
+        }
+
+        std::size_t firstChar;   ///< Index of the first character of the line in the string
+        std::size_t firstVertex; ///< Index of the first vertex of the line in the vertex array
+        float       y;           ///< Vertical position of the baseline of the line
+        float       minX;        ///< Left bound of the characters of the line
+        float       minY;        ///< Top bound of the characters of the line
+        float       maxX;        ///< Right bound of the characters of the line
+        float       maxY;        ///< Bottom bound of the characters of the line
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -289,11 +354,21 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the text's geometry as needing an update
+    ///
+    /// \param index Index of the first character whose geometry changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateGeometry(std::size_t index);
+
     ////////////////////////////////////////////////////////////
     /// \brief Make sure the text's geometry is updated
     ///
     /// All the attributes related to rendering are cached, such
-    /// that the geometry is only updated when necessary.
+    /// that the geometry is only updated when necessary; when
+    /// only the end of the string changed, the lines before the
+    /// first modified one are kept as they are.
     ///
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
@@ -301,14 +376,18 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;             ///< String to display
-    const Font*         m_font;               ///< Font used to display the string
-    unsigned int        m_characterSize;      ///< Base size of characters, in pixels
-    Uint32              m_style;              ///< Text style (see Style enum)
-    Color               m_color;              ///< Text color
-    mutable VertexArray m_vertices;           ///< Vertex array containing the text's geometry
-    mutable FloatRect   m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    String                      m_string;             ///< String to display
+    const Font*                 m_font;               ///< Font used to display the string
+    unsigned int                m_characterSize;      ///< Base size of characters, in pixels
+    Uint32                      m_style;              ///< Text style (see Style enum)
+    Color                       m_color;              ///< Text color
+    bool                        m_distanceField;      ///< Are the glyphs drawn from distance fields?
+    mutable VertexArray         m_vertices;           ///< Vertex array containing the text's geometry
+    mutable std::vector<Uint16> m_indices;            ///< Indices of the triangles of one batch of quads, shared by all the batches
+    mutable FloatRect           m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
+    mutable bool                m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    mutable std::size_t         m_firstChangedChar;   ///< Index of the first character whose geometry must be recomputed
+    mutable std::vector<Line>   m_lines;              ///< Layout of the lines of the text, to rebuild only the modified ones
 };
 
 } // namespace sf
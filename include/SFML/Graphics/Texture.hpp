@@ -313,6 +313,27 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Image& image, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of this texture from another texture
+    ///
+    /// The copy is performed on the GPU through a frame buffer
+    /// object when available; otherwise the pixels of \a texture
+    /// are downloaded with copyToImage and uploaded again.
+    ///
+    /// No additional check is performed on the size of the source
+    /// texture, passing an invalid combination of texture size
+    /// and offset will lead to an undefined behavior.
+    ///
+    /// This function does nothing if either texture was not
+    /// previously created.
+    ///
+    /// \param texture Source texture to copy to this texture
+    /// \param x       X offset in this texture where to copy the source texture
+    /// \param y       Y offset in this texture where to copy the source texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Texture& texture, unsigned int x, unsigned int y);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the texture from the contents of a window
     ///
@@ -420,6 +441,17 @@ public:
     ////////////////////////////////////////////////////////////
     Texture& operator =(const Texture& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this texture with those of another
+    ///
+    /// Unlike the assignment operator, this function doesn't copy
+    /// any pixel: only the OpenGL handles are exchanged.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Texture& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the underlying OpenGL handle of the texture.
     ///
@@ -484,6 +516,7 @@ private:
 
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class SoftwareRenderTarget;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Grid of tiles taken from a tileset texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const Uint16 EmptyTile; ///< Value of the tiles which are not drawn
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty map, with no tile and no tileset.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the map
+    ///
+    /// All the tiles are initialized to \a tile.
+    ///
+    /// \param size     Number of tiles of the map, in each direction
+    /// \param tileSize Size of a tile, in pixels
+    /// \param tile     Initial value of the tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const Vector2u& size, const Vector2u& tileSize, Uint16 tile = EmptyTile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of tiles of the map
+    ///
+    /// \return Number of tiles in each direction
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a tile
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the tileset texture
+    ///
+    /// The tileset is divided into tiles of the size given to
+    /// create, numbered from left to right and top to bottom,
+    /// starting from 0. The texture must stay alive as long as
+    /// the map uses it. If \a texture is NULL, the tiles are
+    /// drawn as white rectangles.
+    ///
+    /// \param texture New tileset texture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the tileset texture
+    ///
+    /// \return Pointer to the tileset, or NULL if none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a tile of the map
+    ///
+    /// If the geometry of the chunk containing the tile is
+    /// cached, only the 4 vertices of the tile are rewritten.
+    /// The behaviour is undefined if the coordinates are out of
+    /// the map.
+    ///
+    /// \param x    Column of the tile
+    /// \param y    Row of the tile
+    /// \param tile Index of the tile in the tileset, or EmptyTile
+    ///
+    /// \see getTile, setTiles
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int x, unsigned int y, Uint16 tile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile of the map
+    ///
+    /// The behaviour is undefined if the coordinates are out of
+    /// the map.
+    ///
+    /// \param x Column of the tile
+    /// \param y Row of the tile
+    ///
+    /// \return Index of the tile in the tileset, or EmptyTile
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint16 getTile(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change all the tiles of the map
+    ///
+    /// \a tiles must point to an array of getSize().x * getSize().y
+    /// tiles, stored row by row.
+    ///
+    /// \param tiles Pointer to the new tiles
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTiles(const Uint16* tiles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the entity
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks of the map to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate the geometry of a chunk of tiles
+    ///
+    /// \param chunkX   Column of the chunk
+    /// \param chunkY   Row of the chunk
+    /// \param vertices Vertex buffer to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    void buildChunk(unsigned int chunkX, unsigned int chunkY, std::vector<Vertex>& vertices) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the 4 vertices of a tile
+    ///
+    /// \param x    Column of the tile
+    /// \param y    Row of the tile
+    /// \param quad Pointer to the vertices of the tile
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeTile(unsigned int x, unsigned int y, Vertex* quad) const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<std::size_t, std::vector<Vertex> > ChunkTable; ///< Table mapping a chunk index to its geometry
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u            m_size;     ///< Number of tiles of the map
+    Vector2u            m_tileSize; ///< Size of a tile, in pixels
+    std::vector<Uint16> m_tiles;    ///< Tiles of the map, row by row
+    const Texture*      m_texture;  ///< Tileset texture
+    unsigned int        m_columns;  ///< Number of tiles per row of the tileset
+    std::vector<Uint16> m_indices;  ///< Indices of the triangles of a chunk, shared by all the chunks
+    mutable ChunkTable  m_chunks;   ///< Geometry of the chunks which were recently visible
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap draws a grid of tiles, such as the layers of a
+/// 2D game level, with a single tileset texture.
+///
+/// The map is split into chunks of 32x32 tiles. The geometry
+/// of a chunk is generated the first time it intersects the
+/// view of the render target, and cached while it stays close
+/// to the view; chunks outside the view are neither generated
+/// nor drawn. Drawing a map thus costs work and memory
+/// proportional to the visible area only, even for maps of
+/// millions of tiles, and changing a single tile only rewrites
+/// its own vertices.
+///
+/// Usage example:
+/// \code
+/// sf::Texture tileset;
+/// tileset.loadFromFile("tileset.png");
+///
+/// sf::TileMap map;
+/// map.create(sf::Vector2u(4096, 4096), sf::Vector2u(16, 16));
+/// map.setTexture(&tileset);
+/// map.setTiles(&level[0]);
+///
+/// // Open a door
+/// map.setTile(120, 45, openDoorTile);
+///
+/// window.draw(map);
+/// \endcode
+///
+/// \see sf::Texture, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
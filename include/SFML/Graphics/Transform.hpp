@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -134,6 +135,36 @@ public:
     ////////////////////////////////////////////////////////////
     FloatRect transformRect(const FloatRect& rectangle) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform an array of 2D points
+    ///
+    /// This function gives the same results as calling
+    /// transformPoint on each point, but is much faster for
+    /// large arrays. \a points and \a result may point to the
+    /// same array, to transform the points in place.
+    ///
+    /// \param points Array of points to transform
+    /// \param result Array receiving the transformed points
+    /// \param count  Number of points in the arrays
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vector2f* points, Vector2f* result, std::size_t count) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform an array of rectangles
+    ///
+    /// This function gives the same results as calling
+    /// transformRect on each rectangle, but is much faster for
+    /// large arrays. \a rectangles and \a result may point to
+    /// the same array, to transform the rectangles in place.
+    ///
+    /// \param rectangles Array of rectangles to transform
+    /// \param result     Array receiving the transformed rectangles
+    /// \param count      Number of rectangles in the arrays
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformRects(const FloatRect* rectangles, FloatRect* result, std::size_t count) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Combine the current transform with another one
     ///
@@ -355,6 +386,17 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the transform is affine
+    ///
+    /// Affine transforms have no projective part: only the
+    /// 2x3 upper part of their 3x3 matrix is significant.
+    ///
+    /// \return True if the transform is affine
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAffine() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -311,6 +311,19 @@ public:
     ////////////////////////////////////////////////////////////
     const Transform& getInverseTransform() const;
 
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify derived classes that the transform has changed
+    ///
+    /// This function is called whenever the position, rotation,
+    /// scale or origin of the object is modified. The default
+    /// implementation does nothing; derived classes can override
+    /// it to invalidate data that depends on the transform.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onTransformChange();
+
 private:
 
     ////////////////////////////////////////////////////////////
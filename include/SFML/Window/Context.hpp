@@ -134,6 +134,14 @@ private:
 /// will take care of deactivating and freeing all the attached
 /// resources.
 ///
+/// On Linux, when SFML is built with the SFML_EGL_HEADLESS
+/// option, contexts can also be created without an X server,
+/// through EGL: this is what happens when the DISPLAY
+/// environment variable is not set, so that sf::RenderTexture
+/// and sf::Shader work in headless processes. Setting the
+/// SFML_HEADLESS environment variable to 1 or 0 forces the
+/// choice. Headless contexts can't render to windows.
+///
 /// Usage example:
 /// \code
 /// void threadFunction(void*)
@@ -38,6 +38,7 @@
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -488,6 +489,50 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called by display() to present the rendered frame
+    ///
+    /// This function is called so that derived classes can
+    /// choose how the frame is presented, for example only
+    /// partially with displayDamage(), or not at all if nothing
+    /// changed. The framerate limit is applied by display()
+    /// afterwards in any case.
+    /// The default implementation presents the whole frame.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Present the rendered frame, telling which parts of it changed
+    ///
+    /// This function is meant to be called from onDisplay().
+    /// The rectangles are stored as consecutive (x, y, width, height)
+    /// quadruples, in pixels, with the origin at the bottom-left
+    /// corner of the window. If the platform supports it, only
+    /// these parts are presented; otherwise the whole frame is.
+    /// If \a count is 0, nothing changed and the buffers are
+    /// not swapped.
+    ///
+    /// \param rectangles Array of 4 * \a count integers
+    /// \param count      Number of rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    void displayDamage(const int* rectangles, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the back buffer
+    ///
+    /// The age is the number of frames that were displayed since
+    /// the back buffer contents were rendered: 1 means that it
+    /// holds the previous frame, 2 the frame before, etc.
+    /// It is 0 if the contents are undefined or if the platform
+    /// can't tell, in which case the whole frame must be redrawn.
+    ///
+    /// \return Age of the back buffer, 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferAge() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
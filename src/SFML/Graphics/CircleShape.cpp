@@ -26,7 +26,57 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
 #include <cmath>
+#include <map>
+
+
+namespace
+{
+    const float pi = 3.141592654f;
+
+    // Maximum number of points for which the unit circle is cached
+    const std::size_t maxCachedPointCount = 1024;
+
+    // Bounds of the number of points chosen by the level of detail
+    const std::size_t minDetailPointCount = 4;
+    const std::size_t maxDetailPointCount = 512;
+
+    // Maximum distance between the polygon and the circle, in pixels, for the level of detail
+    const float detailTolerance = 0.25f;
+
+    // Get the table of the points of the unit circle for a number of points,
+    // shared by all the circles; NULL if the number of points is too high to be cached
+    const std::vector<sf::Vector2f>* getUnitCircle(std::size_t pointCount)
+    {
+        if ((pointCount == 0) || (pointCount > maxCachedPointCount))
+            return NULL;
+
+        // The mutex is function-local, so that circles constructed during the
+        // static initialization of other translation units find it ready
+        static sf::Mutex mutex;
+        sf::Lock lock(mutex);
+
+        // The tables are intentionally never destroyed, circles keep pointers to them
+        static std::map<std::size_t, std::vector<sf::Vector2f> >* tables = new std::map<std::size_t, std::vector<sf::Vector2f> >;
+
+        std::vector<sf::Vector2f>& table = (*tables)[pointCount];
+        if (table.empty())
+        {
+            table.resize(pointCount);
+            for (std::size_t i = 0; i < pointCount; ++i)
+            {
+                float angle = i * 2 * pi / pointCount - pi / 2;
+                table[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+            }
+        }
+
+        return &table;
+    }
+}
 
 
 namespace sf
@@ -34,7 +84,8 @@ namespace sf
 ////////////////////////////////////////////////////////////
 CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
-m_pointCount(pointCount)
+m_pointCount(pointCount),
+m_unitCircle(getUnitCircle(pointCount))
 {
     update();
 }
@@ -59,6 +110,7 @@ float CircleShape::getRadius() const
 void CircleShape::setPointCount(std::size_t count)
 {
     m_pointCount = count;
+    m_unitCircle = getUnitCircle(count);
     update();
 }
 
@@ -72,13 +124,52 @@ std::size_t CircleShape::getPointCount() const
 ////////////////////////////////////////////////////////////
 Vector2f CircleShape::getPoint(std::size_t index) const
 {
-    static const float pi = 3.141592654f;
-
-    float angle = index * 2 * pi / m_pointCount - pi / 2;
-    float x = std::cos(angle) * m_radius;
-    float y = std::sin(angle) * m_radius;
+    float x;
+    float y;
+    if (m_unitCircle)
+    {
+        x = (*m_unitCircle)[index].x * m_radius;
+        y = (*m_unitCircle)[index].y * m_radius;
+    }
+    else
+    {
+        float angle = index * 2 * pi / m_pointCount - pi / 2;
+        x = std::cos(angle) * m_radius;
+        y = std::sin(angle) * m_radius;
+    }
 
     return Vector2f(m_radius + x, m_radius + y);
 }
 
+
+////////////////////////////////////////////////////////////
+void CircleShape::updateLevelOfDetail(const RenderTarget& target, const Transform& transform)
+{
+    // Compute the scale from local units to pixels, along the most stretched axis
+    Transform toTarget = transform * getTransform();
+    Vector2f origin = toTarget.transformPoint(0, 0);
+    Vector2f xAxis  = toTarget.transformPoint(1, 0) - origin;
+    Vector2f yAxis  = toTarget.transformPoint(0, 1) - origin;
+    float scale = std::sqrt(std::max(xAxis.x * xAxis.x + xAxis.y * xAxis.y, yAxis.x * yAxis.x + yAxis.y * yAxis.y));
+
+    const View& view = target.getView();
+    IntRect viewport = target.getViewport(view);
+    scale *= std::max(viewport.width / std::abs(view.getSize().x), viewport.height / std::abs(view.getSize().y));
+
+    // Find the number of points keeping the polygon within the tolerance of the circle:
+    // the distance between a chord and its arc is r * (1 - cos(pi / n))
+    float radius = (m_radius + std::abs(getOutlineThickness())) * scale;
+    std::size_t count = maxDetailPointCount;
+    if (radius <= detailTolerance * 2)
+        count = minDetailPointCount;
+    else if (radius < 1e6f)
+        count = static_cast<std::size_t>(std::ceil(pi / std::acos(1 - detailTolerance / radius)));
+
+    // Use multiples of 4 so that the polygon stays symmetric and doesn't change on every tiny zoom
+    count = std::min(std::max((count + 3) / 4 * 4, minDetailPointCount), maxDetailPointCount);
+
+    if (count != m_pointCount)
+        setPointCount(count);
+}
+
 } // namespace sf
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompactVertex.hpp>
+#include <cmath>
+
+
+namespace
+{
+    // Round a coordinate to the nearest 16-bit integer, clamping it to the range of Int16
+    // (converting an out-of-range float to an integer is undefined behavior)
+    sf::Int16 round(float value)
+    {
+        float rounded = std::floor(value + 0.5f);
+        if (rounded > 32767.f)
+            return 32767;
+        if (!(rounded >= -32768.f))
+            return -32768;
+
+        return static_cast<sf::Int16>(rounded);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompactVertex::CompactVertex() :
+position (0, 0),
+color    (255, 255, 255),
+texCoords(0, 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompactVertex::CompactVertex(const Vector2<Int16>& thePosition) :
+position (thePosition),
+color    (255, 255, 255),
+texCoords(0, 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompactVertex::CompactVertex(const Vector2<Int16>& thePosition, const Color& theColor) :
+position (thePosition),
+color    (theColor),
+texCoords(0, 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompactVertex::CompactVertex(const Vector2<Int16>& thePosition, const Vector2<Int16>& theTexCoords) :
+position (thePosition),
+color    (255, 255, 255),
+texCoords(theTexCoords)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompactVertex::CompactVertex(const Vector2<Int16>& thePosition, const Color& theColor, const Vector2<Int16>& theTexCoords) :
+position (thePosition),
+color    (theColor),
+texCoords(theTexCoords)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompactVertex::CompactVertex(const Vertex& vertex) :
+position (round(vertex.position.x), round(vertex.position.y)),
+color    (vertex.color),
+texCoords(round(vertex.texCoords.x), round(vertex.texCoords.y))
+{
+}
+
+} // namespace sf
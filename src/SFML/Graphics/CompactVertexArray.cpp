@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompactVertexArray.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompactVertexArray::CompactVertexArray() :
+m_vertices     (),
+m_primitiveType(Points)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompactVertexArray::CompactVertexArray(PrimitiveType type, std::size_t vertexCount) :
+m_vertices     (vertexCount),
+m_primitiveType(type)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompactVertexArray::getVertexCount() const
+{
+    return m_vertices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+CompactVertex& CompactVertexArray::operator [](std::size_t index)
+{
+    return m_vertices[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const CompactVertex& CompactVertexArray::operator [](std::size_t index) const
+{
+    return m_vertices[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void CompactVertexArray::clear()
+{
+    m_vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void CompactVertexArray::resize(std::size_t vertexCount)
+{
+    m_vertices.resize(vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompactVertexArray::append(const CompactVertex& vertex)
+{
+    m_vertices.push_back(vertex);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompactVertexArray::setPrimitiveType(PrimitiveType type)
+{
+    m_primitiveType = type;
+}
+
+
+////////////////////////////////////////////////////////////
+PrimitiveType CompactVertexArray::getPrimitiveType() const
+{
+    return m_primitiveType;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect CompactVertexArray::getBounds() const
+{
+    if (!m_vertices.empty())
+    {
+        Int16 left   = m_vertices[0].position.x;
+        Int16 top    = m_vertices[0].position.y;
+        Int16 right  = m_vertices[0].position.x;
+        Int16 bottom = m_vertices[0].position.y;
+
+        for (std::size_t i = 1; i < m_vertices.size(); ++i)
+        {
+            Vector2<Int16> position = m_vertices[i].position;
+
+            // Update left and right
+            if (position.x < left)
+                left = position.x;
+            else if (position.x > right)
+                right = position.x;
+
+            // Update top and bottom
+            if (position.y < top)
+                top = position.y;
+            else if (position.y > bottom)
+                bottom = position.y;
+        }
+
+        return FloatRect(static_cast<float>(left), static_cast<float>(top), static_cast<float>(right - left), static_cast<float>(bottom - top));
+    }
+    else
+    {
+        // Array is empty
+        return FloatRect();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CompactVertexArray::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_vertices.empty())
+        target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
+}
+
+} // namespace sf
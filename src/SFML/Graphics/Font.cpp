@@ -27,18 +27,24 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/Text.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/Thread.hpp>
 #include <SFML/System/Err.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
+#include FT_SIZES_H
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 
 
 namespace
@@ -60,6 +66,330 @@ namespace
     void close(FT_Stream)
     {
     }
+
+    // Combine the parameters of a glyph into a single key
+    sf::Uint64 combine(sf::Uint32 codePoint, unsigned int characterSize, bool bold)
+    {
+        return (static_cast<sf::Uint64>(characterSize) << 33) | (static_cast<sf::Uint64>(bold ? 1 : 0) << 32) | codePoint;
+    }
+
+    // Flag added to the key of the glyphs whose metrics were loaded without their pixels
+    const sf::Uint64 metricsOnly = static_cast<sf::Uint64>(1) << 63;
+
+    // Hash a glyph key
+    std::size_t hash(sf::Uint64 key)
+    {
+        sf::Uint32 low  = static_cast<sf::Uint32>(key);
+        sf::Uint32 high = static_cast<sf::Uint32>(key >> 32);
+        sf::Uint32 h = (low * 2654435761u) ^ (high * 2246822519u);
+        return h ^ (h >> 15);
+    }
+
+    // Load a glyph with the face's current size and convert it to white pixels with alpha coverage;
+    // the size of the bitmap is stored in the glyph's texture rect, its position is left to the caller
+    bool rasterizeGlyph(FT_Library library, FT_Face face, sf::Uint32 codePoint, bool bold, sf::Glyph& glyph, std::vector<sf::Uint8>& buffer)
+    {
+        // Load the glyph corresponding to the code point
+        if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
+            return false;
+
+        // Retrieve the glyph
+        FT_Glyph glyphDesc;
+        if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+            return false;
+
+        // Apply bold if necessary -- first technique using outline (highest quality)
+        FT_Pos weight = 1 << 6;
+        bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (bold && outline)
+        {
+            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+            FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        }
+
+        // Convert the glyph to a bitmap (i.e. rasterize it)
+        FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+        FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+        // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+        if (bold && !outline)
+        {
+            FT_Bitmap_Embolden(library, &bitmap, weight, weight);
+        }
+
+        // Compute the glyph's advance offset
+        glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+        if (bold)
+            glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+        int width  = bitmap.width;
+        int height = bitmap.rows;
+
+        if ((width > 0) && (height > 0))
+        {
+            glyph.textureRect = sf::IntRect(0, 0, width, height);
+
+            // Compute the glyph's bounding box
+            glyph.bounds.left   = static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+            glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+            glyph.bounds.width  = static_cast<float>(face->glyph->metrics.width) / static_cast<float>(1 << 6);
+            glyph.bounds.height = static_cast<float>(face->glyph->metrics.height) / static_cast<float>(1 << 6);
+
+            // Extract the glyph's pixels from the bitmap
+            buffer.resize(width * height * 4, 255);
+            const sf::Uint8* pixels = bitmap.buffer;
+            if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+            {
+                // Pixels are 1 bit monochrome values
+                for (int y = 0; y < height; ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = (x + y * width) * 4 + 3;
+                        buffer[index] = ((pixels[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+            else
+            {
+                // Pixels are 8 bits gray levels
+                for (int y = 0; y < height; ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = (x + y * width) * 4 + 3;
+                        buffer[index] = pixels[x];
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+        }
+
+        // Delete the FT glyph
+        FT_Done_Glyph(glyphDesc);
+
+        return true;
+    }
+
+    // Value used for "no feature pixel" in distance transforms
+    const float infinity = 1e20f;
+
+    // Compute the squared distance transform of a sampled function in one dimension
+    // (Felzenszwalb and Huttenlocher, "Distance Transforms of Sampled Functions")
+    void distanceTransform(const float* f, float* d, int n, int* v, float* z)
+    {
+        int k = 0;
+        v[0] = 0;
+        z[0] = -infinity;
+        z[1] = infinity;
+        for (int q = 1; q < n; ++q)
+        {
+            float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+            while (s <= z[k])
+            {
+                --k;
+                s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+            }
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = infinity;
+        }
+
+        k = 0;
+        for (int q = 0; q < n; ++q)
+        {
+            while (z[k + 1] < q)
+                ++k;
+            d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+        }
+    }
+
+    // Compute the squared distance transform of a grid, in place
+    // (feature pixels are 0, the other ones are infinity)
+    void distanceTransform(std::vector<float>& grid, int width, int height)
+    {
+        int size = std::max(width, height);
+        std::vector<float> f(size);
+        std::vector<float> d(size);
+        std::vector<float> z(size + 1);
+        std::vector<int>   v(size);
+
+        // Transform along the columns
+        for (int x = 0; x < width; ++x)
+        {
+            for (int y = 0; y < height; ++y)
+                f[y] = grid[x + y * width];
+            distanceTransform(&f[0], &d[0], height, &v[0], &z[0]);
+            for (int y = 0; y < height; ++y)
+                grid[x + y * width] = d[y];
+        }
+
+        // Then along the rows
+        for (int y = 0; y < height; ++y)
+        {
+            float* row = &grid[y * width];
+            std::copy(row, row + width, f.begin());
+            distanceTransform(&f[0], row, width, &v[0], &z[0]);
+        }
+    }
+
+    // Identifier and version of the glyph cache files
+    const sf::Uint32 cacheMagic   = 0x43464653; // "SFFC"
+    const sf::Uint32 cacheVersion = 1;
+
+    // Append little-endian values to a cache buffer
+    void writeUint32(std::vector<sf::Uint8>& output, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            output.push_back(static_cast<sf::Uint8>(value >> (i * 8)));
+    }
+    void writeUint64(std::vector<sf::Uint8>& output, sf::Uint64 value)
+    {
+        writeUint32(output, static_cast<sf::Uint32>(value));
+        writeUint32(output, static_cast<sf::Uint32>(value >> 32));
+    }
+    void writeFloat(std::vector<sf::Uint8>& output, float value)
+    {
+        sf::Uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeUint32(output, bits);
+    }
+
+    // Read little-endian values from a cache buffer, with bounds checking
+    struct CacheReader
+    {
+        CacheReader(const std::vector<char>& buffer) : data(buffer.empty() ? NULL : reinterpret_cast<const sf::Uint8*>(&buffer[0])), size(buffer.size()), position(0) {}
+
+        bool readUint32(sf::Uint32& value)
+        {
+            if (size - position < 4)
+                return false;
+            value = data[position] | (data[position + 1] << 8) | (data[position + 2] << 16) | (static_cast<sf::Uint32>(data[position + 3]) << 24);
+            position += 4;
+            return true;
+        }
+        bool readUint64(sf::Uint64& value)
+        {
+            sf::Uint32 low, high;
+            if (!readUint32(low) || !readUint32(high))
+                return false;
+            value = (static_cast<sf::Uint64>(high) << 32) | low;
+            return true;
+        }
+        bool readFloat(float& value)
+        {
+            sf::Uint32 bits;
+            if (!readUint32(bits))
+                return false;
+            std::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+        const sf::Uint8* readBytes(std::size_t count)
+        {
+            if (size - position < count)
+                return NULL;
+            position += count;
+            return data + position - count;
+        }
+
+        const sf::Uint8* data;
+        std::size_t      size;
+        std::size_t      position;
+    };
+
+    // Get the whole font file in memory, so that other faces can be created from it
+    const FT_Byte* getFaceData(FT_Face face, std::vector<FT_Byte>& buffer)
+    {
+        // Faces loaded from memory (or memory-mapped files) can be read directly
+        FT_Stream stream = face->stream;
+        if (stream->base)
+            return stream->base;
+
+        if (!stream->read || (stream->size == 0))
+            return NULL;
+
+        buffer.resize(stream->size);
+        if (stream->read(stream, 0, &buffer[0], stream->size) != stream->size)
+            return NULL;
+
+        return &buffer[0];
+    }
+
+    // Compute a hash of the font data (FNV-1a), to detect obsolete cache files
+    sf::Uint64 hashFace(FT_Face face)
+    {
+        std::vector<FT_Byte> buffer;
+        const FT_Byte* data = getFaceData(face, buffer);
+        if (!data)
+            return 0;
+
+        sf::Uint64 hash = 14695981039346656037ULL;
+        for (unsigned long i = 0; i < face->stream->size; ++i)
+            hash = (hash ^ data[i]) * 1099511628211ULL;
+
+        return (hash ^ static_cast<sf::Uint64>(face->face_index)) * 1099511628211ULL;
+    }
+
+    // Glyph to rasterize in the background
+    struct GlyphJob
+    {
+        static bool isTaller(const GlyphJob& left, const GlyphJob& right)
+        {
+            return left.glyph.textureRect.height > right.glyph.textureRect.height;
+        }
+
+        sf::Uint32             codePoint;
+        unsigned int           characterSize;
+        bool                   bold;
+        bool                   done;
+        sf::Glyph              glyph;
+        std::vector<sf::Uint8> pixels;
+    };
+
+    // Worker rasterizing a range of glyph jobs with its own FreeType library and face
+    struct GlyphRasterizer
+    {
+        void run()
+        {
+            FT_Library library;
+            if (FT_Init_FreeType(&library) != 0)
+                return;
+
+            FT_Face face;
+            if (FT_New_Memory_Face(library, data, size, faceIndex, &face) == 0)
+            {
+                if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0)
+                {
+                    unsigned int currentSize = 0;
+                    for (GlyphJob* job = begin; job != end; ++job)
+                    {
+                        if (job->characterSize != currentSize)
+                        {
+                            if (FT_Set_Pixel_Sizes(face, 0, job->characterSize) != 0)
+                                continue;
+                            currentSize = job->characterSize;
+                        }
+
+                        job->done = rasterizeGlyph(library, face, job->codePoint, job->bold, job->glyph, job->pixels);
+                    }
+                }
+
+                FT_Done_Face(face);
+            }
+
+            FT_Done_FreeType(library);
+        }
+
+        const FT_Byte* data;
+        FT_Long        size;
+        FT_Long        faceIndex;
+        GlyphJob*      begin;
+        GlyphJob*      end;
+    };
 }
 
 
@@ -67,11 +397,12 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_refCount (NULL),
-m_info     ()
+m_library     (NULL),
+m_face        (NULL),
+m_streamRec   (NULL),
+m_refCount    (NULL),
+m_info        (),
+m_kerningCount(0)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -81,13 +412,18 @@ m_info     ()
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_refCount   (copy.m_refCount),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_library     (copy.m_library),
+m_face        (copy.m_face),
+m_streamRec   (copy.m_streamRec),
+m_refCount    (copy.m_refCount),
+m_info        (copy.m_info),
+m_pages       (copy.m_pages),
+m_glyphTable  (copy.m_glyphTable),
+m_glyphs      (copy.m_glyphs),
+m_kerningTable(copy.m_kerningTable),
+m_kerningCount(copy.m_kerningCount),
+m_sizes       (copy.m_sizes),
+m_pixelBuffer (copy.m_pixelBuffer)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -282,192 +618,750 @@ bool Font::loadFromStream(InputStream& stream)
 
 
 ////////////////////////////////////////////////////////////
-const Font::Info& Font::getInfo() const
-{
-    return m_info;
-}
-
-
-////////////////////////////////////////////////////////////
-const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
+bool Font::saveCache(const std::string& filename, const std::vector<unsigned int>& sizes) const
 {
-    // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
-
-    // Build the key by combining the code point and the bold flag
-    Uint32 key = ((bold ? 1 : 0) << 31) | codePoint;
-
-    // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
     {
-        // Found: just return it
-        return it->second;
+        err() << "Failed to save font cache \"" << filename << "\" (no font loaded)" << std::endl;
+        return false;
     }
-    else
+
+    // Keep only the sizes which have a page
+    std::vector<unsigned int> savedSizes;
+    for (std::vector<unsigned int>::const_iterator it = sizes.begin(); it != sizes.end(); ++it)
     {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        if ((m_pages.find(*it) != m_pages.end()) && (std::find(savedSizes.begin(), savedSizes.end(), *it) == savedSizes.end()))
+            savedSizes.push_back(*it);
     }
-}
-
 
-////////////////////////////////////////////////////////////
-float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
-{
-    // Special case where first or second is 0 (null character)
-    if (first == 0 || second == 0)
-        return 0.f;
-
-    FT_Face face = static_cast<FT_Face>(m_face);
+    std::vector<Uint8> output;
+    writeUint32(output, cacheMagic);
+    writeUint32(output, cacheVersion);
+    writeUint64(output, hashFace(face));
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    // Write the pages: their allocation state and the alpha channel of their texture
+    // (the color channels of glyph textures are always white)
+    writeUint32(output, static_cast<Uint32>(savedSizes.size()));
+    for (std::vector<unsigned int>::const_iterator it = savedSizes.begin(); it != savedSizes.end(); ++it)
     {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        const Page& page = m_pages.find(*it)->second;
+        Image image = page.texture.copyToImage();
+
+        writeUint32(output, *it);
+        writeUint32(output, image.getSize().x);
+        writeUint32(output, image.getSize().y);
+        writeUint32(output, page.usedArea);
+        writeUint32(output, static_cast<Uint32>(page.skyline.size()));
+        for (std::vector<SkylineNode>::const_iterator node = page.skyline.begin(); node != page.skyline.end(); ++node)
+        {
+            writeUint32(output, node->x);
+            writeUint32(output, node->y);
+            writeUint32(output, node->width);
+        }
 
-        // Get the kerning vector
-        FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+        std::size_t pixelCount = image.getSize().x * image.getSize().y;
+        const Uint8* pixels = image.getPixelsPtr();
+        for (std::size_t i = 0; i < pixelCount; ++i)
+            output.push_back(pixels[i * 4 + 3]);
+    }
 
-        // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+    // Write the glyphs of the saved sizes
+    std::vector<std::pair<Uint64, const Glyph*> > glyphs;
+    for (GlyphTable::const_iterator it = m_glyphTable.begin(); it != m_glyphTable.end(); ++it)
+    {
+        unsigned int size = static_cast<unsigned int>(it->key >> 33);
+        if (it->index && (std::find(savedSizes.begin(), savedSizes.end(), size) != savedSizes.end()))
+            glyphs.push_back(std::make_pair(it->key, &m_glyphs[it->index - 1]));
+    }
+    writeUint32(output, static_cast<Uint32>(glyphs.size()));
+    for (std::vector<std::pair<Uint64, const Glyph*> >::const_iterator it = glyphs.begin(); it != glyphs.end(); ++it)
+    {
+        const Glyph& glyph = *it->second;
+        writeUint64(output, it->first);
+        writeFloat(output, glyph.advance);
+        writeFloat(output, glyph.bounds.left);
+        writeFloat(output, glyph.bounds.top);
+        writeFloat(output, glyph.bounds.width);
+        writeFloat(output, glyph.bounds.height);
+        writeUint32(output, static_cast<Uint32>(glyph.textureRect.left));
+        writeUint32(output, static_cast<Uint32>(glyph.textureRect.top));
+        writeUint32(output, static_cast<Uint32>(glyph.textureRect.width));
+        writeUint32(output, static_cast<Uint32>(glyph.textureRect.height));
+    }
 
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
+    // Write the kerning offsets of the saved sizes
+    std::vector<const KerningSlot*> kernings;
+    for (KerningTable::const_iterator it = m_kerningTable.begin(); it != m_kerningTable.end(); ++it)
+    {
+        unsigned int size = static_cast<unsigned int>(it->key >> 42);
+        if (it->used && (std::find(savedSizes.begin(), savedSizes.end(), size) != savedSizes.end()))
+            kernings.push_back(&*it);
     }
-    else
+    writeUint32(output, static_cast<Uint32>(kernings.size()));
+    for (std::vector<const KerningSlot*>::const_iterator it = kernings.begin(); it != kernings.end(); ++it)
     {
-        // Invalid font, or no kerning
-        return 0.f;
+        writeUint64(output, (*it)->key);
+        writeFloat(output, (*it)->value);
+    }
+
+    std::ofstream file(filename.c_str(), std::ios_base::binary | std::ios_base::trunc);
+    if (!file || !file.write(reinterpret_cast<const char*>(&output[0]), output.size()))
+    {
+        err() << "Failed to save font cache \"" << filename << "\" (cannot write file)" << std::endl;
+        return false;
     }
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-float Font::getLineSpacing(unsigned int characterSize) const
+bool Font::loadCache(const std::string& filename) const
 {
     FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+        return false;
 
-    if (face && setCurrentSize(characterSize))
+    // Read the whole file at once
+    std::vector<char> buffer;
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+        return false;
+    file.seekg(0, std::ios_base::end);
+    std::streamsize fileSize = file.tellg();
+    if (fileSize <= 0)
+        return false;
+    file.seekg(0, std::ios_base::beg);
+    buffer.resize(static_cast<std::size_t>(fileSize));
+    if (!file.read(&buffer[0], fileSize))
+        return false;
+
+    CacheReader reader(buffer);
+
+    // Check the header, and that the cache was built from the same font data
+    Uint32 magic, version;
+    Uint64 hash;
+    if (!reader.readUint32(magic) || !reader.readUint32(version) || !reader.readUint64(hash) ||
+        (magic != cacheMagic) || (version != cacheVersion))
     {
-        return static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
+        err() << "Failed to load font cache \"" << filename << "\" (invalid file)" << std::endl;
+        return false;
     }
-    else
+    if (hash != hashFace(face))
     {
-        return 0.f;
+        err() << "Failed to load font cache \"" << filename << "\" (it was built from a different font)" << std::endl;
+        return false;
     }
-}
-
-
-////////////////////////////////////////////////////////////
-float Font::getUnderlinePosition(unsigned int characterSize) const
-{
-    FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && setCurrentSize(characterSize))
+    // Parse the whole file before modifying the font, so that an invalid file leaves it untouched
+    Uint32 maximumSize = Texture::getMaximumSize();
+    std::vector<CachedPage> pages;
+    std::vector<unsigned int> sizes;
+    Uint32 pageCount;
+    bool valid = reader.readUint32(pageCount);
+    for (Uint32 i = 0; valid && (i < pageCount); ++i)
     {
-        // Return a fixed position if font is a bitmap font
-        if (!FT_IS_SCALABLE(face))
-            return characterSize / 10.f;
+        CachedPage page;
+        Uint32 nodeCount;
+        valid = reader.readUint32(page.size) && reader.readUint32(page.width) && reader.readUint32(page.height) &&
+                reader.readUint32(page.usedArea) && reader.readUint32(nodeCount) &&
+                (page.width > 0) && (page.height > 0) && (nodeCount > 0) && (nodeCount <= page.width) &&
+                (page.width <= maximumSize) && (page.height <= maximumSize);
+
+        // The skyline segments must be non-empty, contiguous, and cover the width of the page exactly
+        Uint32 right = 0;
+        for (Uint32 j = 0; valid && (j < nodeCount); ++j)
+        {
+            Uint32 x, y, width;
+            valid = reader.readUint32(x) && reader.readUint32(y) && reader.readUint32(width) &&
+                    (x == right) && (width > 0) && (width <= page.width - right) && (y <= page.height);
+            page.skyline.push_back(SkylineNode(x, y, width));
+            right = x + width;
+        }
+        valid = valid && (right == page.width);
 
-        return -static_cast<float>(FT_MulFix(face->underline_position, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+        page.alpha = valid ? reader.readBytes(static_cast<std::size_t>(page.width) * page.height) : NULL;
+        valid = (page.alpha != NULL);
+
+        // Skip the sizes which are already in use, their glyphs are elsewhere in their texture
+        if (valid && (m_pages.find(page.size) == m_pages.end()) && (std::find(sizes.begin(), sizes.end(), page.size) == sizes.end()))
+        {
+            sizes.push_back(page.size);
+            pages.push_back(page);
+        }
     }
-    else
+
+    std::vector<std::pair<Uint64, Glyph> > glyphs;
+    Uint32 glyphCount = 0;
+    valid = valid && reader.readUint32(glyphCount);
+    for (Uint32 i = 0; valid && (i < glyphCount); ++i)
     {
-        return 0.f;
+        Uint64 key;
+        Glyph glyph;
+        Uint32 left, top, width, height;
+        valid = reader.readUint64(key) && reader.readFloat(glyph.advance) &&
+                reader.readFloat(glyph.bounds.left) && reader.readFloat(glyph.bounds.top) &&
+                reader.readFloat(glyph.bounds.width) && reader.readFloat(glyph.bounds.height) &&
+                reader.readUint32(left) && reader.readUint32(top) && reader.readUint32(width) && reader.readUint32(height);
+        glyph.textureRect = IntRect(static_cast<int>(left), static_cast<int>(top), static_cast<int>(width), static_cast<int>(height));
+
+        std::vector<unsigned int>::const_iterator size = std::find(sizes.begin(), sizes.end(), static_cast<unsigned int>(key >> 33));
+        if (valid && (size != sizes.end()))
+        {
+            // The glyph must lie inside its page
+            const CachedPage& page = pages[size - sizes.begin()];
+            valid = (left <= page.width) && (width <= page.width - left) && (top <= page.height) && (height <= page.height - top);
+            if (valid)
+                glyphs.push_back(std::make_pair(key, glyph));
+        }
     }
-}
 
+    std::vector<std::pair<Uint64, float> > kernings;
+    Uint32 kerningCount = 0;
+    valid = valid && reader.readUint32(kerningCount);
+    for (Uint32 i = 0; valid && (i < kerningCount); ++i)
+    {
+        Uint64 key;
+        float kerning;
+        valid = reader.readUint64(key) && reader.readFloat(kerning);
 
-////////////////////////////////////////////////////////////
-float Font::getUnderlineThickness(unsigned int characterSize) const
-{
-    FT_Face face = static_cast<FT_Face>(m_face);
+        if (valid && (std::find(sizes.begin(), sizes.end(), static_cast<unsigned int>(key >> 42)) != sizes.end()))
+            kernings.push_back(std::make_pair(key, kerning));
+    }
 
-    if (face && setCurrentSize(characterSize))
+    if (!valid)
     {
-        // Return a fixed thickness if font is a bitmap font
-        if (!FT_IS_SCALABLE(face))
-            return characterSize / 14.f;
+        err() << "Failed to load font cache \"" << filename << "\" (invalid file)" << std::endl;
+        return false;
+    }
 
-        return static_cast<float>(FT_MulFix(face->underline_thickness, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+    // Everything was read successfully: we can now insert the data in the font
+    std::vector<Uint8> pixels;
+    for (std::vector<CachedPage>::const_iterator it = pages.begin(); it != pages.end(); ++it)
+    {
+        // Upload the pixels straight to the texture
+        std::size_t pixelCount = static_cast<std::size_t>(it->width) * it->height;
+        pixels.assign(pixelCount * 4, 255);
+        for (std::size_t i = 0; i < pixelCount; ++i)
+            pixels[i * 4 + 3] = it->alpha[i];
+
+        Page& page = m_pages[it->size];
+        page.texture.create(it->width, it->height);
+        page.texture.update(&pixels[0]);
+        page.skyline  = it->skyline;
+        page.usedArea = it->usedArea;
     }
-    else
+
+    for (std::vector<std::pair<Uint64, Glyph> >::const_iterator it = glyphs.begin(); it != glyphs.end(); ++it)
     {
-        return 0.f;
+        m_glyphs.push_back(it->second);
+        insertGlyph(it->first, m_glyphs.size());
     }
+
+    for (std::vector<std::pair<Uint64, float> >::const_iterator it = kernings.begin(); it != kernings.end(); ++it)
+    {
+        if (m_kerningTable.empty() || !m_kerningTable[findKerningSlot(it->first)].used)
+            insertKerning(it->first, it->second);
+    }
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-const Texture& Font::getTexture(unsigned int characterSize) const
+const Font::Info& Font::getInfo() const
 {
-    return m_pages[characterSize].texture;
+    return m_info;
 }
 
 
 ////////////////////////////////////////////////////////////
-Font& Font::operator =(const Font& right)
+const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
-    Font temp(right);
+    // Build the key by combining the code point, the character size and the bold flag
+    Uint64 key = combine(codePoint, characterSize, bold);
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    // Search the glyph into the cache
+    if (!m_glyphTable.empty())
+    {
+        std::size_t index = m_glyphTable[findGlyphSlot(key)].index;
+        if (index)
+        {
+            // Found: just return it
+            return m_glyphs[index - 1];
+        }
+    }
 
-    return *this;
+    // Not found: we have to load it
+    m_glyphs.push_back(loadGlyph(codePoint, characterSize, bold));
+    insertGlyph(key, m_glyphs.size());
+
+    return m_glyphs.back();
 }
 
 
 ////////////////////////////////////////////////////////////
-void Font::cleanup()
+const Glyph& Font::getGlyphMetrics(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
-    // Check if we must destroy the FreeType pointers
-    if (m_refCount)
+    Uint64 key = combine(codePoint, characterSize, bold);
+
+    // Search the glyph into the cache, either fully loaded or as metrics only
+    if (!m_glyphTable.empty())
     {
-        // Decrease the reference counter
-        (*m_refCount)--;
+        std::size_t index = m_glyphTable[findGlyphSlot(key)].index;
+        if (!index)
+            index = m_glyphTable[findGlyphSlot(key | metricsOnly)].index;
+        if (index)
+            return m_glyphs[index - 1];
+    }
 
-        // Free the resources only if we are the last owner
-        if (*m_refCount == 0)
-        {
-            // Delete the reference counter
-            delete m_refCount;
+    // Not found: load its metrics only
+    m_glyphs.push_back(loadGlyphMetrics(codePoint, characterSize, bold));
+    insertGlyph(key | metricsOnly, m_glyphs.size());
 
-            // Destroy the font face
-            if (m_face)
-                FT_Done_Face(static_cast<FT_Face>(m_face));
+    return m_glyphs.back();
+}
 
-            // Destroy the stream rec instance, if any (must be done after FT_Done_Face!)
-            if (m_streamRec)
-                delete static_cast<FT_StreamRec*>(m_streamRec);
 
-            // Close the library
-            if (m_library)
-                FT_Done_FreeType(static_cast<FT_Library>(m_library));
+////////////////////////////////////////////////////////////
+const Glyph& Font::getDistanceFieldGlyph(Uint32 codePoint) const
+{
+    // Distance field glyphs are stored with a character size of 0
+    Uint64 key = combine(codePoint, 0, false);
+
+    // Search the glyph into the cache
+    if (!m_glyphTable.empty())
+    {
+        std::size_t index = m_glyphTable[findGlyphSlot(key)].index;
+        if (index)
+        {
+            // Found: just return it
+            return m_glyphs[index - 1];
         }
     }
 
-    // Reset members
-    m_library   = NULL;
-    m_face      = NULL;
-    m_streamRec = NULL;
-    m_refCount  = NULL;
-    m_pages.clear();
-    m_pixelBuffer.clear();
+    // Not found: we have to load it
+    m_glyphs.push_back(loadDistanceFieldGlyph(codePoint));
+    insertGlyph(key, m_glyphs.size());
+
+    return m_glyphs.back();
 }
 
 
 ////////////////////////////////////////////////////////////
-Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
+float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
+{
+    // Special case where first or second is 0 (null character)
+    if (first == 0 || second == 0)
+        return 0.f;
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    if (face && FT_HAS_KERNING(face))
+    {
+        // Build the key by combining the character size and the two code points
+        // (valid code points fit in 21 bits)
+        Uint64 key = (static_cast<Uint64>(characterSize) << 42) |
+                     (static_cast<Uint64>(first & 0x1FFFFF) << 21) |
+                      static_cast<Uint64>(second & 0x1FFFFF);
+
+        // Search the pair into the cache
+        if (!m_kerningTable.empty())
+        {
+            const KerningSlot& slot = m_kerningTable[findKerningSlot(key)];
+            if (slot.used)
+                return slot.value;
+        }
+
+        // Not found: ask FreeType, and cache the result (even if it's zero, which is the most common case)
+        float kerning = 0.f;
+        if (setCurrentSize(characterSize))
+        {
+            // Convert the characters to indices
+            FT_UInt index1 = FT_Get_Char_Index(face, first);
+            FT_UInt index2 = FT_Get_Char_Index(face, second);
+
+            // Get the kerning vector
+            FT_Vector vector;
+            FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &vector);
+
+            // X advance is already in pixels for bitmap fonts
+            if (!FT_IS_SCALABLE(face))
+                kerning = static_cast<float>(vector.x);
+            else
+                kerning = static_cast<float>(vector.x) / static_cast<float>(1 << 6);
+        }
+
+        insertKerning(key, kerning);
+
+        return kerning;
+    }
+    else
+    {
+        // Invalid font, or no kerning
+        return 0.f;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Font::measure(const String& string, unsigned int characterSize, Uint32 style) const
+{
+    if (!m_face || string.isEmpty())
+        return FloatRect();
+
+    // Compute values related to the text style; like in sf::Text, the underline
+    // and strike through lines don't contribute to the bounds
+    bool  bold   = (style & Text::Bold) != 0;
+    float italic = (style & Text::Italic) ? 0.208f : 0.f; // 12 degrees
+    float hspace = getGlyphMetrics(L' ', characterSize, bold).advance;
+    float vspace = getLineSpacing(characterSize);
+
+    float  minX     = static_cast<float>(characterSize);
+    float  minY     = static_cast<float>(characterSize);
+    float  maxX     = 0.f;
+    float  maxY     = 0.f;
+    float  x        = 0.f;
+    float  y        = static_cast<float>(characterSize);
+    Uint32 prevChar = 0;
+    for (std::size_t i = 0; i < string.getSize(); ++i)
+    {
+        Uint32 curChar = string[i];
+
+        // Apply the kerning offset
+        x += getKerning(prevChar, curChar, characterSize);
+        prevChar = curChar;
+
+        // Handle special characters
+        if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
+        {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+
+            switch (curChar)
+            {
+                case ' ':  x += hspace;        break;
+                case '\t': x += hspace * 4;    break;
+                case '\n': y += vspace; x = 0; break;
+            }
+
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        // Extend the bounds with the glyph's quad
+        const Glyph& glyph = getGlyphMetrics(curChar, characterSize, bold);
+
+        float left   = glyph.bounds.left;
+        float top    = glyph.bounds.top;
+        float right  = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+        minX = std::min(minX, x + left - italic * bottom);
+        maxX = std::max(maxX, x + right - italic * top);
+        minY = std::min(minY, y + top);
+        maxY = std::max(maxY, y + bottom);
+
+        x += glyph.advance;
+    }
+
+    return FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+
+////////////////////////////////////////////////////////////
+String Font::wrap(const String& string, unsigned int characterSize, float width, Uint32 style) const
+{
+    String result = string;
+    if (!m_face)
+        return result;
+
+    bool  bold   = (style & Text::Bold) != 0;
+    float hspace = getGlyphMetrics(L' ', characterSize, bold).advance;
+
+    float       x          = 0.f;
+    Uint32      prevChar   = 0;
+    std::size_t lineStart  = 0;
+    std::size_t breakPoint = String::InvalidPos;
+    for (std::size_t i = 0; i < result.getSize(); ++i)
+    {
+        Uint32 curChar = result[i];
+
+        // Explicit line breaks start a new line
+        if (curChar == L'\n')
+        {
+            x          = 0.f;
+            prevChar   = curChar;
+            lineStart  = i + 1;
+            breakPoint = String::InvalidPos;
+            continue;
+        }
+
+        // Compute the advance of the character
+        float advance = getKerning(prevChar, curChar, characterSize);
+        switch (curChar)
+        {
+            case ' ':  advance += hspace;                                                break;
+            case '\t': advance += hspace * 4;                                            break;
+            default:   advance += getGlyphMetrics(curChar, characterSize, bold).advance; break;
+        }
+
+        // Whitespace may overflow, the line is broken at the next visible character
+        bool whitespace = (curChar == ' ') || (curChar == '\t');
+        if (!whitespace && (x + advance > width) && (i > lineStart))
+        {
+            if (breakPoint != String::InvalidPos)
+            {
+                // Break the line at the last whitespace, and lay out the next word again
+                result[breakPoint] = L'\n';
+                i = breakPoint;
+            }
+            else
+            {
+                // The word doesn't fit on a line: break it before the current character
+                result.insert(i, String(L'\n'));
+            }
+
+            x          = 0.f;
+            prevChar   = L'\n';
+            lineStart  = i + 1;
+            breakPoint = String::InvalidPos;
+            continue;
+        }
+
+        x += advance;
+        prevChar = curChar;
+        if (whitespace)
+            breakPoint = i;
+    }
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getLineSpacing(unsigned int characterSize) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    if (face && setCurrentSize(characterSize))
+    {
+        return static_cast<float>(face->size->metrics.height) / static_cast<float>(1 << 6);
+    }
+    else
+    {
+        return 0.f;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getUnderlinePosition(unsigned int characterSize) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    if (face && setCurrentSize(characterSize))
+    {
+        // Return a fixed position if font is a bitmap font
+        if (!FT_IS_SCALABLE(face))
+            return characterSize / 10.f;
+
+        return -static_cast<float>(FT_MulFix(face->underline_position, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+    }
+    else
+    {
+        return 0.f;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getUnderlineThickness(unsigned int characterSize) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    if (face && setCurrentSize(characterSize))
+    {
+        // Return a fixed thickness if font is a bitmap font
+        if (!FT_IS_SCALABLE(face))
+            return characterSize / 14.f;
+
+        return static_cast<float>(FT_MulFix(face->underline_thickness, face->size->metrics.y_scale)) / static_cast<float>(1 << 6);
+    }
+    else
+    {
+        return 0.f;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& Font::getTexture(unsigned int characterSize) const
+{
+    return m_pages[characterSize].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getTextureOccupancy(unsigned int characterSize) const
+{
+    PageTable::const_iterator it = m_pages.find(characterSize);
+    if (it == m_pages.end())
+        return 0.f;
+
+    Vector2u size = it->second.texture.getSize();
+    return static_cast<float>(it->second.usedArea) / (size.x * size.y);
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& Font::getDistanceFieldTexture() const
+{
+    return m_pages[0].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+Font& Font::operator =(const Font& right)
+{
+    Font temp(right);
+
+    std::swap(m_library,      temp.m_library);
+    std::swap(m_face,         temp.m_face);
+    std::swap(m_streamRec,    temp.m_streamRec);
+    std::swap(m_refCount,     temp.m_refCount);
+    std::swap(m_info,         temp.m_info);
+    std::swap(m_pages,        temp.m_pages);
+    std::swap(m_glyphTable,   temp.m_glyphTable);
+    std::swap(m_glyphs,       temp.m_glyphs);
+    std::swap(m_kerningTable, temp.m_kerningTable);
+    std::swap(m_kerningCount, temp.m_kerningCount);
+    std::swap(m_sizes,        temp.m_sizes);
+    std::swap(m_pixelBuffer,  temp.m_pixelBuffer);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::cleanup()
+{
+    // Check if we must destroy the FreeType pointers
+    if (m_refCount)
+    {
+        // Decrease the reference counter
+        (*m_refCount)--;
+
+        // Free the resources only if we are the last owner
+        if (*m_refCount == 0)
+        {
+            // Delete the reference counter
+            delete m_refCount;
+
+            // Destroy the font face
+            if (m_face)
+                FT_Done_Face(static_cast<FT_Face>(m_face));
+
+            // Destroy the stream rec instance, if any (must be done after FT_Done_Face!)
+            if (m_streamRec)
+                delete static_cast<FT_StreamRec*>(m_streamRec);
+
+            // Close the library
+            if (m_library)
+                FT_Done_FreeType(static_cast<FT_Library>(m_library));
+        }
+    }
+
+    // Reset members
+    m_library      = NULL;
+    m_face         = NULL;
+    m_streamRec    = NULL;
+    m_refCount     = NULL;
+    m_kerningCount = 0;
+    m_pages.clear();
+    m_glyphTable.clear();
+    m_glyphs.clear();
+    m_kerningTable.clear();
+    m_sizes.clear();
+    m_pixelBuffer.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::findGlyphSlot(Uint64 key) const
+{
+    // Linear probing: walk from the home slot until the key or an empty slot is found
+    std::size_t mask = m_glyphTable.size() - 1;
+    std::size_t slot = hash(key) & mask;
+    while (m_glyphTable[slot].index && (m_glyphTable[slot].key != key))
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::insertGlyph(Uint64 key, std::size_t index) const
+{
+    // Keep the table at most half full so that probe sequences stay short
+    if (index * 2 > m_glyphTable.size())
+    {
+        GlyphTable oldTable(std::max<std::size_t>(64, m_glyphTable.size() * 2));
+        m_glyphTable.swap(oldTable);
+
+        for (GlyphTable::const_iterator it = oldTable.begin(); it != oldTable.end(); ++it)
+        {
+            if (it->index)
+                m_glyphTable[findGlyphSlot(it->key)] = *it;
+        }
+    }
+
+    m_glyphTable[findGlyphSlot(key)] = GlyphSlot(key, index);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::findKerningSlot(Uint64 key) const
+{
+    // Linear probing: walk from the home slot until the key or an empty slot is found
+    std::size_t mask = m_kerningTable.size() - 1;
+    std::size_t slot = hash(key) & mask;
+    while (m_kerningTable[slot].used && (m_kerningTable[slot].key != key))
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::insertKerning(Uint64 key, float kerning) const
+{
+    // Keep the table at most half full so that probe sequences stay short
+    ++m_kerningCount;
+    if (m_kerningCount * 2 > m_kerningTable.size())
+    {
+        KerningTable oldTable(std::max<std::size_t>(256, m_kerningTable.size() * 2));
+        m_kerningTable.swap(oldTable);
+
+        for (KerningTable::const_iterator it = oldTable.begin(); it != oldTable.end(); ++it)
+        {
+            if (it->used)
+                m_kerningTable[findKerningSlot(it->key)] = *it;
+        }
+    }
+
+    m_kerningTable[findKerningSlot(key)] = KerningSlot(key, kerning);
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
     // The glyph to return
     Glyph glyph;
@@ -481,41 +1375,193 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
     if (!setCurrentSize(characterSize))
         return glyph;
 
-    // Load the glyph corresponding to the code point
-    if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
+    // Rasterize the glyph
+    if (!rasterizeGlyph(static_cast<FT_Library>(m_library), face, codePoint, bold, glyph, m_pixelBuffer))
         return glyph;
 
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+    // Write its pixels to the texture
+    writeGlyph(glyph, characterSize, m_pixelBuffer);
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    // Done :)
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::loadGlyphMetrics(Uint32 codePoint, unsigned int characterSize, bool bold) const
+{
+    // The glyph to return
+    Glyph glyph;
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face || !setCurrentSize(characterSize))
+        return glyph;
+
+    // Load the glyph with the same options as when it is rasterized, so that the metrics match
+    if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
         return glyph;
 
-    // Apply bold if necessary -- first technique using outline (highest quality)
+    FT_GlyphSlot slot = face->glyph;
     FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (bold && outline)
+
+    // Compute the glyph's advance offset
+    glyph.advance = static_cast<float>(slot->metrics.horiAdvance) / static_cast<float>(1 << 6);
+    if (bold)
+        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+    // Find out whether the rasterized glyph would contain any pixel
+    bool empty;
+    if (slot->format == FT_GLYPH_FORMAT_OUTLINE)
     {
-        FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-        FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        if (bold)
+            FT_Outline_Embolden(&slot->outline, weight);
+
+        // The bitmap covers the control box of the outline, rounded to whole pixels
+        FT_BBox box;
+        FT_Outline_Get_CBox(&slot->outline, &box);
+        FT_Pos width  = ((box.xMax + 63) & -64) - (box.xMin & -64);
+        FT_Pos height = ((box.yMax + 63) & -64) - (box.yMin & -64);
+        empty = (slot->outline.n_points == 0) || (width == 0) || (height == 0);
+    }
+    else
+    {
+        empty = (slot->bitmap.width == 0) || (slot->bitmap.rows == 0);
     }
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
-
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (bold && !outline)
+    // Compute the glyph's bounding box
+    if (!empty)
     {
-        FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+        glyph.bounds.left   = static_cast<float>(slot->metrics.horiBearingX) / static_cast<float>(1 << 6);
+        glyph.bounds.top    = -static_cast<float>(slot->metrics.horiBearingY) / static_cast<float>(1 << 6);
+        glyph.bounds.width  = static_cast<float>(slot->metrics.width) / static_cast<float>(1 << 6);
+        glyph.bounds.height = static_cast<float>(slot->metrics.height) / static_cast<float>(1 << 6);
     }
 
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::loadDistanceFieldGlyph(Uint32 codePoint) const
+{
+    // The glyph to return
+    Glyph glyph;
+
+    // First, transform our ugly void* to a FT_Face
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face || !FT_IS_SCALABLE(face))
+        return glyph;
+
+    // The outline is rasterized with a higher resolution, and the
+    // resulting distance field is then averaged down to the reference size
+    const int upscale = 4;
+    if (!setCurrentSize(DistanceFieldSize * upscale))
+        return glyph;
+
+    // Load the glyph without hinting, so that it scales uniformly
+    if (FT_Load_Char(face, codePoint, FT_LOAD_NO_HINTING | FT_LOAD_RENDER) != 0)
+        return glyph;
+
+    FT_GlyphSlot slot = face->glyph;
+    const FT_Bitmap& bitmap = slot->bitmap;
+
     // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
-    if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+    glyph.advance = static_cast<float>(slot->metrics.horiAdvance) / static_cast<float>(upscale << 6);
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
+    if ((bitmap.width > 0) && (bitmap.rows > 0))
+    {
+        // Size of the glyph at the reference size, and of its field
+        int width       = (static_cast<int>(bitmap.width) + upscale - 1) / upscale;
+        int height      = (static_cast<int>(bitmap.rows) + upscale - 1) / upscale;
+        int spread      = DistanceFieldSpread;
+        int fieldWidth  = width + 2 * spread;
+        int fieldHeight = height + 2 * spread;
+
+        // Compute the glyph's bounding box
+        glyph.bounds.left   = static_cast<float>(slot->bitmap_left) / upscale;
+        glyph.bounds.top    = -static_cast<float>(slot->bitmap_top) / upscale;
+        glyph.bounds.width  = static_cast<float>(width);
+        glyph.bounds.height = static_cast<float>(height);
+
+        // Build the mask of the pixels which are inside the glyph, in the high resolution grid
+        int gridWidth  = fieldWidth * upscale;
+        int gridHeight = fieldHeight * upscale;
+        std::vector<bool> inside(gridWidth * gridHeight, false);
+        const Uint8* pixels = bitmap.buffer;
+        for (int y = 0; y < static_cast<int>(bitmap.rows); ++y)
+        {
+            for (int x = 0; x < static_cast<int>(bitmap.width); ++x)
+            {
+                bool covered = (bitmap.pixel_mode == FT_PIXEL_MODE_MONO) ? (pixels[x / 8] & (1 << (7 - (x % 8)))) != 0 : pixels[x] >= 128;
+                inside[(x + spread * upscale) + (y + spread * upscale) * gridWidth] = covered;
+            }
+            pixels += bitmap.pitch;
+        }
+
+        // Compute the squared distances to the nearest inside and outside pixels
+        std::vector<float> toInside(gridWidth * gridHeight);
+        std::vector<float> toOutside(gridWidth * gridHeight);
+        for (std::size_t i = 0; i < inside.size(); ++i)
+        {
+            toInside[i]  = inside[i] ? 0.f : infinity;
+            toOutside[i] = inside[i] ? infinity : 0.f;
+        }
+        distanceTransform(toInside, gridWidth, gridHeight);
+        distanceTransform(toOutside, gridWidth, gridHeight);
+
+        // Average the signed distances (positive inside) of each block of
+        // the grid, and map them to [0 .. 255] in the alpha channel
+        m_pixelBuffer.resize(fieldWidth * fieldHeight * 4, 255);
+        for (int y = 0; y < fieldHeight; ++y)
+        {
+            for (int x = 0; x < fieldWidth; ++x)
+            {
+                float distance = 0.f;
+                for (int j = 0; j < upscale; ++j)
+                {
+                    for (int i = 0; i < upscale; ++i)
+                    {
+                        std::size_t index = (x * upscale + i) + (y * upscale + j) * gridWidth;
+                        if (inside[index])
+                            distance += std::sqrt(toOutside[index]) - 0.5f;
+                        else
+                            distance -= std::sqrt(toInside[index]) - 0.5f;
+                    }
+                }
+                distance /= upscale * upscale * upscale;
+
+                float value = 0.5f + distance / (2 * spread);
+                value = std::max(0.f, std::min(1.f, value));
+                m_pixelBuffer[(x + y * fieldWidth) * 4 + 3] = static_cast<Uint8>(value * 255.f + 0.5f);
+            }
+        }
+
+        // Write the field to the texture, and keep only the glyph's area in its texture rect
+        glyph.textureRect = IntRect(0, 0, fieldWidth, fieldHeight);
+        writeGlyph(glyph, 0, m_pixelBuffer);
+        glyph.textureRect.left   += spread;
+        glyph.textureRect.top    += spread;
+        glyph.textureRect.width  -= 2 * spread;
+        glyph.textureRect.height -= 2 * spread;
+
+        // Force an OpenGL flush, so that the font's texture will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
+
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::writeGlyph(Glyph& glyph, unsigned int characterSize, const std::vector<Uint8>& pixels) const
+{
+    int width  = glyph.textureRect.width;
+    int height = glyph.textureRect.height;
 
     if ((width > 0) && (height > 0))
     {
@@ -536,171 +1582,301 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
         glyph.textureRect.width -= 2 * padding;
         glyph.textureRect.height -= 2 * padding;
 
-        // Compute the glyph's bounding box
-        glyph.bounds.left   = static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  = static_cast<float>(face->glyph->metrics.width) / static_cast<float>(1 << 6);
-        glyph.bounds.height = static_cast<float>(face->glyph->metrics.height) / static_cast<float>(1 << 6);
+        // Write the pixels to the texture
+        unsigned int x = glyph.textureRect.left;
+        unsigned int y = glyph.textureRect.top;
+        unsigned int w = glyph.textureRect.width;
+        unsigned int h = glyph.textureRect.height;
+        page.texture.update(&pixels[0], w, h, x, y);
+    }
+}
 
-        // Extract the glyph's pixels from the bitmap
-        m_pixelBuffer.resize(width * height * 4, 255);
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphs(const std::vector<std::pair<Uint32, Uint32> >& ranges, const std::vector<unsigned int>& sizes, bool bold, unsigned int threadCount) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+        return;
+
+    // Build the list of the glyphs which are not loaded yet and exist in the font
+    std::vector<Uint64> keys;
+    for (std::vector<unsigned int>::const_iterator size = sizes.begin(); size != sizes.end(); ++size)
+    {
+        // Character size 0 is reserved for the distance field glyphs
+        if (*size == 0)
+            continue;
+
+        for (std::vector<std::pair<Uint32, Uint32> >::const_iterator range = ranges.begin(); range != ranges.end(); ++range)
         {
-            // Pixels are 1 bit monochrome values
-            for (int y = 0; y < height; ++y)
+            for (Uint32 codePoint = range->first; (codePoint <= range->second) && (codePoint <= 0x10FFFF); ++codePoint)
             {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = ((pixels[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
+                Uint64 key = combine(codePoint, *size, bold);
+                if (!m_glyphTable.empty() && m_glyphTable[findGlyphSlot(key)].index)
+                    continue;
+
+                if (FT_Get_Char_Index(face, codePoint) != 0)
+                    keys.push_back(key);
             }
         }
-        else
+    }
+
+    // Sorting the keys groups the glyphs by character size, so that
+    // workers rarely have to change the size of their face
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    if (keys.empty())
+        return;
+
+    std::vector<GlyphJob> jobs(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        jobs[i].codePoint     = static_cast<Uint32>(keys[i] & 0xFFFFFFFF);
+        jobs[i].characterSize = static_cast<unsigned int>(keys[i] >> 33);
+        jobs[i].bold          = bold;
+        jobs[i].done          = false;
+    }
+
+    // Worker threads can't share our face, they each create their own from the font data
+    std::vector<FT_Byte> buffer;
+    const FT_Byte* data = getFaceData(face, buffer);
+    if (data)
+    {
+        // Rasterize the glyphs on the worker threads, one contiguous chunk each
+        std::size_t count = std::max(1u, std::min<unsigned int>(threadCount, static_cast<unsigned int>(jobs.size())));
+        std::vector<GlyphRasterizer> rasterizers(count);
+        std::vector<Thread*> threads(count);
+        for (std::size_t i = 0; i < count; ++i)
         {
-            // Pixels are 8 bits gray levels
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = pixels[x];
-                }
-                pixels += bitmap.pitch;
-            }
+            rasterizers[i].data      = data;
+            rasterizers[i].size      = static_cast<FT_Long>(face->stream->size);
+            rasterizers[i].faceIndex = face->face_index;
+            rasterizers[i].begin     = &jobs[0] + jobs.size() * i / count;
+            rasterizers[i].end       = &jobs[0] + jobs.size() * (i + 1) / count;
+            threads[i] = new Thread(&GlyphRasterizer::run, &rasterizers[i]);
+            threads[i]->launch();
         }
 
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left;
-        unsigned int y = glyph.textureRect.top;
-        unsigned int w = glyph.textureRect.width;
-        unsigned int h = glyph.textureRect.height;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            threads[i]->wait();
+            delete threads[i];
+        }
     }
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
+    // Rasterize what the workers couldn't handle on this thread
+    for (std::vector<GlyphJob>::iterator job = jobs.begin(); job != jobs.end(); ++job)
+    {
+        if (!job->done && setCurrentSize(job->characterSize))
+            job->done = rasterizeGlyph(static_cast<FT_Library>(m_library), face, job->codePoint, job->bold, job->glyph, job->pixels);
+    }
+
+    // Write all the glyphs to the textures, tallest first so that they are packed tightly,
+    // and flush only once at the end
+    std::sort(jobs.begin(), jobs.end(), GlyphJob::isTaller);
+    for (std::vector<GlyphJob>::iterator job = jobs.begin(); job != jobs.end(); ++job)
+    {
+        if (!job->done)
+            continue;
+
+        writeGlyph(job->glyph, job->characterSize, job->pixels);
+
+        m_glyphs.push_back(job->glyph);
+        insertGlyph(combine(job->codePoint, job->characterSize, job->bold), m_glyphs.size());
+    }
 
     // Force an OpenGL flush, so that the font's texture will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
     glCheck(glFlush());
-
-    // Done :)
-    return glyph;
 }
 
 
 ////////////////////////////////////////////////////////////
 IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
+    for (;;)
     {
-        float ratio = static_cast<float>(height) / it->height;
+        unsigned int textureWidth  = page.texture.getSize().x;
+        unsigned int textureHeight = page.texture.getSize().y;
+
+        // Find the position where the top of the glyph would be the lowest,
+        // preferring the narrowest segment in case of equality
+        std::size_t  bestIndex  = page.skyline.size();
+        unsigned int bestBottom = 0;
+        unsigned int bestWidth  = 0;
+        unsigned int bestY      = 0;
+        for (std::size_t i = 0; i < page.skyline.size(); ++i)
+        {
+            const SkylineNode& node = page.skyline[i];
+            if (node.x + width > textureWidth)
+                break;
+
+            // The glyph rests on the highest segment that it spans
+            unsigned int y = 0;
+            unsigned int remaining = width;
+            for (std::size_t j = i; remaining > 0; ++j)
+            {
+                y = std::max(y, page.skyline[j].y);
+                remaining -= std::min(remaining, page.skyline[j].width);
+            }
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
+            if (y + height > textureHeight)
+                continue;
 
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
+            if ((bestIndex == page.skyline.size()) || (y + height < bestBottom) || ((y + height == bestBottom) && (node.width < bestWidth)))
+            {
+                bestIndex  = i;
+                bestBottom = y + height;
+                bestWidth  = node.width;
+                bestY      = y;
+            }
+        }
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
+        if (bestIndex < page.skyline.size())
+        {
+            IntRect rect(page.skyline[bestIndex].x, bestY, width, height);
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
-    }
+            // Raise the skyline over the new rectangle
+            page.skyline.insert(page.skyline.begin() + bestIndex, SkylineNode(rect.left, bestBottom, width));
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
-    {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
-        {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
+            // Shrink or remove the segments now covered by the rectangle
+            unsigned int right = rect.left + width;
+            std::size_t next = bestIndex + 1;
+            while ((next < page.skyline.size()) && (page.skyline[next].x < right))
             {
-                // Make the texture 2 times bigger
-                Image newImage;
-                newImage.create(textureWidth * 2, textureHeight * 2, Color(255, 255, 255, 0));
-                newImage.copy(page.texture.copyToImage(), 0, 0);
-                page.texture.loadFromImage(newImage);
+                SkylineNode& node = page.skyline[next];
+                unsigned int overlap = right - node.x;
+                if (overlap < node.width)
+                {
+                    node.x += overlap;
+                    node.width -= overlap;
+                    break;
+                }
+
+                page.skyline.erase(page.skyline.begin() + next);
             }
-            else
+
+            // Merge the neighbor segments which have the same height
+            for (std::size_t i = 0; i + 1 < page.skyline.size(); )
             {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
-                return IntRect(0, 0, 2, 2);
+                if (page.skyline[i].y == page.skyline[i + 1].y)
+                {
+                    page.skyline[i].width += page.skyline[i + 1].width;
+                    page.skyline.erase(page.skyline.begin() + i + 1);
+                }
+                else
+                {
+                    ++i;
+                }
             }
-        }
 
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
-    }
+            page.usedArea += width * height;
 
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
-
-    // Update the row informations
-    row->width += width;
+            return rect;
+        }
 
-    return rect;
+        // Not enough space: resize the texture if possible
+        if (!growPage(page))
+        {
+            // Oops, we've reached the maximum texture size...
+            err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+            return IntRect(0, 0, 2, 2);
+        }
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Font::setCurrentSize(unsigned int characterSize) const
 {
-    // FT_Set_Pixel_Sizes is an expensive function, so we must call it
-    // only when necessary to avoid killing performances
+    // FT_Set_Pixel_Sizes is an expensive function, so we create a FreeType
+    // size object for each character size and call it only once per size;
+    // switching between existing size objects is then cheap
 
     FT_Face face = static_cast<FT_Face>(m_face);
     FT_UShort currentSize = face->size->metrics.x_ppem;
 
-    if (currentSize != characterSize)
-    {
-        FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+    if (currentSize == characterSize)
+        return true;
 
-        if (result == FT_Err_Invalid_Pixel_Size)
+    // Activate the size object of this character size if it already exists
+    SizeTable::const_iterator it = m_sizes.find(characterSize);
+    if (it != m_sizes.end())
+        return FT_Activate_Size(static_cast<FT_Size>(it->second)) == FT_Err_Ok;
+
+    // Otherwise create it
+    FT_Size size;
+    if ((FT_New_Size(face, &size) != FT_Err_Ok) || (FT_Activate_Size(size) != FT_Err_Ok))
+        return false;
+
+    FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+
+    if (result == FT_Err_Invalid_Pixel_Size)
+    {
+        // In the case of bitmap fonts, resizing can
+        // fail if the requested size is not available
+        if (!FT_IS_SCALABLE(face))
         {
-            // In the case of bitmap fonts, resizing can
-            // fail if the requested size is not available
-            if (!FT_IS_SCALABLE(face))
-            {
-                err() << "Failed to set bitmap font size to " << characterSize << std::endl;
-                err() << "Available sizes are: ";
-                for (int i = 0; i < face->num_fixed_sizes; ++i)
-                    err() << face->available_sizes[i].height << " ";
-                err() << std::endl;
-            }
+            err() << "Failed to set bitmap font size to " << characterSize << std::endl;
+            err() << "Available sizes are: ";
+            for (int i = 0; i < face->num_fixed_sizes; ++i)
+                err() << face->available_sizes[i].height << " ";
+            err() << std::endl;
         }
-
-        return result == FT_Err_Ok;
     }
-    else
+
+    if (result != FT_Err_Ok)
     {
-        return true;
+        // Destroying the active size makes FreeType fall back to the face's default one
+        FT_Done_Size(size);
+        return false;
     }
+
+    m_sizes.insert(std::make_pair(characterSize, static_cast<void*>(size)));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::growPage(Page& page) const
+{
+    unsigned int textureWidth  = page.texture.getSize().x;
+    unsigned int textureHeight = page.texture.getSize().y;
+    if ((textureWidth * 2 > Texture::getMaximumSize()) || (textureHeight * 2 > Texture::getMaximumSize()))
+        return false;
+
+    // Create a texture 2 times bigger
+    Texture texture;
+    texture.setSmooth(page.texture.isSmooth());
+    if (!texture.create(textureWidth * 2, textureHeight * 2))
+        return false;
+
+    // Copy the existing glyphs directly on the GPU, instead of
+    // downloading them and uploading them again
+    texture.update(page.texture, 0, 0);
+
+    // Fill the three new quarters with transparent white, so that the padding
+    // around glyphs stays clean; a single quarter-sized buffer is enough
+    std::vector<Uint8> pixels(textureWidth * textureHeight * 4, 255);
+    for (std::size_t i = 3; i < pixels.size(); i += 4)
+        pixels[i] = 0;
+    texture.update(&pixels[0], textureWidth, textureHeight, textureWidth, 0);
+    texture.update(&pixels[0], textureWidth, textureHeight, 0, textureHeight);
+    texture.update(&pixels[0], textureWidth, textureHeight, textureWidth, textureHeight);
+
+    page.texture.swap(texture);
+
+    // The new area on the right is free from the top of the texture
+    page.skyline.push_back(SkylineNode(textureWidth, 0, textureWidth));
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
 Font::Page::Page() :
-nextRow(3)
+usedArea(0)
 {
     // Make sure that the texture is initialized by default
     sf::Image image;
@@ -714,6 +1890,10 @@ nextRow(3)
     // Create the texture
     texture.loadFromImage(image);
     texture.setSmooth(true);
+
+    // Glyphs can be placed anywhere but on the white square and its 1 pixel border
+    skyline.push_back(SkylineNode(0, 3, 3));
+    skyline.push_back(SkylineNode(3, 0, image.getSize().x - 3));
 }
 
 } // namespace sf
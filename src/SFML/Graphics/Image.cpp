@@ -158,6 +158,43 @@ bool Image::saveToFile(const std::string& filename) const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Image::saveToMemory(std::vector<Uint8>& output, const std::string& format, unsigned int compression, unsigned int quality) const
+{
+    return priv::ImageLoader::getInstance().saveImageToMemory(format, output, m_pixels, m_size, compression, quality);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::getInfo(const std::string& filename, Vector2u& size, unsigned int& channelCount)
+{
+    #ifndef SFML_SYSTEM_ANDROID
+
+        return priv::ImageLoader::getInstance().getImageInfoFromFile(filename, size, channelCount);
+
+    #else
+
+        priv::ResourceStream stream(filename);
+        return getInfo(stream, size, channelCount);
+
+    #endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::getInfo(const void* data, std::size_t dataSize, Vector2u& size, unsigned int& channelCount)
+{
+    return priv::ImageLoader::getInstance().getImageInfoFromMemory(data, dataSize, size, channelCount);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::getInfo(InputStream& stream, Vector2u& size, unsigned int& channelCount)
+{
+    return priv::ImageLoader::getInstance().getImageInfoFromStream(stream, size, channelCount);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2u Image::getSize() const
 {
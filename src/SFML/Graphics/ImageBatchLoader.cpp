@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageBatchLoader.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageBatchLoader::ImageBatchLoader() :
+m_nextJob(0),
+m_done   (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageBatchLoader::~ImageBatchLoader()
+{
+    wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatchLoader::launch(const std::vector<std::string>& filenames, unsigned int threadCount)
+{
+    Lock workersLock(m_workersMutex);
+
+    // Finish the previous batch first
+    wait();
+
+    // Make sure the image loader singleton (and the decoder tables that
+    // it initializes) is created before the workers start
+    priv::ImageLoader::getInstance();
+
+    {
+        Lock lock(m_mutex);
+
+        m_filenames = filenames;
+        m_images.clear();
+        m_images.resize(filenames.size());
+        m_status.assign(filenames.size(), Pending);
+        m_completed.clear();
+        m_nextJob = 0;
+        m_done = 0;
+    }
+
+    // Don't start more workers than there are images to load
+    if (threadCount == 0)
+        threadCount = 1;
+    if (threadCount > filenames.size())
+        threadCount = static_cast<unsigned int>(filenames.size());
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        Thread* worker = new Thread(&ImageBatchLoader::work, this);
+        m_workers.push_back(worker);
+        worker->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatchLoader::wait()
+{
+    Lock lock(m_workersMutex);
+
+    for (std::vector<Thread*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    m_workers.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageBatchLoader::isFinished() const
+{
+    Lock lock(m_mutex);
+
+    return m_done == m_filenames.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageBatchLoader::getCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_filenames.size();
+}
+
+
+////////////////////////////////////////////////////////////
+ImageBatchLoader::Status ImageBatchLoader::getStatus(std::size_t index) const
+{
+    Lock lock(m_mutex);
+
+    return m_status[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& ImageBatchLoader::getImage(std::size_t index) const
+{
+    // No lock needed: the workers never touch an image again once it is processed,
+    // and only the owning thread can replace the images with launch()
+    return m_images[index];
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageBatchLoader::pollCompleted(std::size_t& index)
+{
+    Lock lock(m_mutex);
+
+    if (m_completed.empty())
+        return false;
+
+    index = m_completed.front();
+    m_completed.pop_front();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageBatchLoader::work()
+{
+    for (;;)
+    {
+        // Pick the next image to decode
+        std::size_t index;
+        {
+            Lock lock(m_mutex);
+
+            if (m_nextJob >= m_filenames.size())
+                return;
+
+            index = m_nextJob++;
+        }
+
+        // Decode it outside the lock, each worker owns the slot it picked
+        bool loaded = m_images[index].loadFromFile(m_filenames[index]);
+
+        // Publish the result
+        {
+            Lock lock(m_mutex);
+
+            m_status[index] = loaded ? Loaded : Failed;
+            m_completed.push_back(index);
+            ++m_done;
+        }
+    }
+}
+
+} // namespace sf
@@ -37,7 +37,9 @@ extern "C"
     #include <jpeglib.h>
     #include <jerror.h>
 }
+#include <algorithm>
 #include <cctype>
+#include <cstdlib>
 
 
 namespace
@@ -66,6 +68,341 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+    // Append integers to a byte buffer
+    void writeUint16Le(std::vector<sf::Uint8>& output, sf::Uint32 value)
+    {
+        output.push_back(static_cast<sf::Uint8>(value & 0xFF));
+        output.push_back(static_cast<sf::Uint8>((value >> 8) & 0xFF));
+    }
+    void writeUint32Le(std::vector<sf::Uint8>& output, sf::Uint32 value)
+    {
+        writeUint16Le(output, value & 0xFFFF);
+        writeUint16Le(output, value >> 16);
+    }
+    void writeUint32Be(std::vector<sf::Uint8>& output, sf::Uint32 value)
+    {
+        output.push_back(static_cast<sf::Uint8>((value >> 24) & 0xFF));
+        output.push_back(static_cast<sf::Uint8>((value >> 16) & 0xFF));
+        output.push_back(static_cast<sf::Uint8>((value >> 8) & 0xFF));
+        output.push_back(static_cast<sf::Uint8>(value & 0xFF));
+    }
+
+    // Lookup tables used by the PNG encoder, built once when the library is loaded
+    struct PngTables
+    {
+        PngTables()
+        {
+            // CRC-32 of every byte value
+            for (sf::Uint32 i = 0; i < 256; ++i)
+            {
+                sf::Uint32 crc = i;
+                for (int j = 0; j < 8; ++j)
+                    crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+                crcs[i] = crc;
+            }
+
+            // Fixed Huffman codes of the DEFLATE literal/length alphabet, bit-reversed
+            for (unsigned int symbol = 0; symbol < 288; ++symbol)
+            {
+                sf::Uint32 code;
+                unsigned int length;
+                if (symbol <= 143)      {code = 0x30 + symbol;        length = 8;}
+                else if (symbol <= 255) {code = 0x190 + symbol - 144; length = 9;}
+                else if (symbol <= 279) {code = symbol - 256;         length = 7;}
+                else                    {code = 0xC0 + symbol - 280;  length = 8;}
+
+                sf::Uint32 reversed = 0;
+                for (unsigned int i = 0; i < length; ++i)
+                    reversed |= ((code >> i) & 1) << (length - 1 - i);
+
+                codes[symbol] = static_cast<sf::Uint16>(reversed);
+                lengths[symbol] = static_cast<sf::Uint8>(length);
+            }
+        }
+
+        sf::Uint32 crcs[256];
+        sf::Uint16 codes[288];
+        sf::Uint8  lengths[288];
+    };
+    const PngTables pngTables;
+
+    // Compute the CRC-32 of a PNG chunk
+    sf::Uint32 crc32(const sf::Uint8* data, std::size_t size, sf::Uint32 crc)
+    {
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i)
+            crc = pngTables.crcs[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    // Compute the Adler-32 checksum of a zlib stream
+    sf::Uint32 adler32(const sf::Uint8* data, std::size_t size)
+    {
+        sf::Uint32 a = 1;
+        sf::Uint32 b = 0;
+        while (size > 0)
+        {
+            // 5552 is the largest block that can't overflow the sums
+            std::size_t block = std::min<std::size_t>(size, 5552);
+            for (std::size_t i = 0; i < block; ++i)
+            {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+            data += block;
+            size -= block;
+        }
+        return (b << 16) | a;
+    }
+
+    // Write bits to a DEFLATE stream, least significant bit first
+    class BitWriter
+    {
+    public:
+
+        BitWriter(std::vector<sf::Uint8>& output) : m_output(output), m_buffer(0), m_count(0) {}
+
+        void write(sf::Uint32 bits, unsigned int count)
+        {
+            m_buffer |= bits << m_count;
+            m_count += count;
+            while (m_count >= 8)
+            {
+                m_output.push_back(static_cast<sf::Uint8>(m_buffer & 0xFF));
+                m_buffer >>= 8;
+                m_count -= 8;
+            }
+        }
+
+        void writeSymbol(unsigned int symbol)
+        {
+            write(pngTables.codes[symbol], pngTables.lengths[symbol]);
+        }
+
+        void flush()
+        {
+            if (m_count > 0)
+                m_output.push_back(static_cast<sf::Uint8>(m_buffer & 0xFF));
+            m_buffer = 0;
+            m_count = 0;
+        }
+
+    private:
+
+        std::vector<sf::Uint8>& m_output;
+        sf::Uint32              m_buffer;
+        unsigned int            m_count;
+    };
+
+    // Write a DEFLATE stream made of uncompressed blocks
+    void deflateStored(const sf::Uint8* data, std::size_t size, std::vector<sf::Uint8>& output)
+    {
+        std::size_t offset = 0;
+        do
+        {
+            std::size_t block = std::min<std::size_t>(size - offset, 65535);
+            output.push_back(offset + block == size ? 1 : 0); // BFINAL, BTYPE = 00 (stored)
+            writeUint16Le(output, static_cast<sf::Uint32>(block));
+            writeUint16Le(output, static_cast<sf::Uint32>(~block & 0xFFFF));
+            output.insert(output.end(), data + offset, data + offset + block);
+            offset += block;
+        }
+        while (offset < size);
+    }
+
+    // Hash the 3 bytes at the given position
+    sf::Uint32 hash3(const sf::Uint8* data, unsigned int bits)
+    {
+        sf::Uint32 key = data[0] | (data[1] << 8) | (data[2] << 16);
+        return (key * 2654435761u) >> (32 - bits);
+    }
+
+    // Write a DEFLATE stream with fixed Huffman codes and greedy single-probe matching;
+    // much faster than a full search, at the price of a lower compression ratio
+    void deflateFast(const sf::Uint8* data, std::size_t size, std::vector<sf::Uint8>& output)
+    {
+        static const unsigned short lengthBase[]  = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258, 259};
+        static const unsigned char  lengthExtra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static const unsigned short distBase[]    = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577, 32769};
+        static const unsigned char  distExtra[]   = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+        const unsigned int hashBits = 15;
+
+        BitWriter writer(output);
+        writer.write(1, 1); // BFINAL
+        writer.write(1, 2); // BTYPE = 01 (fixed Huffman codes)
+
+        // Last position (plus one) at which each 3-byte sequence was seen
+        std::vector<std::size_t> table(1 << hashBits, 0);
+
+        std::size_t i = 0;
+        while (i + 3 <= size)
+        {
+            sf::Uint32 hash = hash3(data + i, hashBits);
+            std::size_t candidate = table[hash];
+            table[hash] = i + 1;
+
+            if (candidate && (i + 1 - candidate <= 32768))
+            {
+                const sf::Uint8* match = data + candidate - 1;
+                std::size_t maxLength = std::min<std::size_t>(258, size - i);
+                std::size_t length = 0;
+                while ((length < maxLength) && (match[length] == data[i + length]))
+                    ++length;
+
+                if (length >= 3)
+                {
+                    unsigned int distance = static_cast<unsigned int>(i + 1 - candidate);
+
+                    unsigned int code = 0;
+                    while (length >= lengthBase[code + 1])
+                        ++code;
+                    writer.writeSymbol(257 + code);
+                    writer.write(static_cast<sf::Uint32>(length - lengthBase[code]), lengthExtra[code]);
+
+                    code = 0;
+                    while (distance >= distBase[code + 1])
+                        ++code;
+                    sf::Uint32 reversed = 0;
+                    for (unsigned int bit = 0; bit < 5; ++bit)
+                        reversed |= ((code >> bit) & 1) << (4 - bit);
+                    writer.write(reversed, 5);
+                    writer.write(distance - distBase[code], distExtra[code]);
+
+                    i += length;
+                    continue;
+                }
+            }
+
+            writer.writeSymbol(data[i++]);
+        }
+
+        // Write the remaining bytes as literals
+        while (i < size)
+            writer.writeSymbol(data[i++]);
+
+        writer.writeSymbol(256); // end of block
+        writer.flush();
+    }
+
+    // Compress data into a zlib stream
+    void zlibCompress(sf::Uint8* data, std::size_t size, unsigned int compression, std::vector<sf::Uint8>& output)
+    {
+        if (compression >= 4)
+        {
+            // Use stb_image_write's compressor, its quality is the number of matches kept per hash bucket
+            static const int qualities[] = {5, 6, 8, 12, 20, 32};
+            int length = 0;
+            unsigned char* compressed = stbi_zlib_compress(data, static_cast<int>(size), &length, qualities[compression - 4]);
+            if (compressed)
+            {
+                output.insert(output.end(), compressed, compressed + length);
+                free(compressed);
+            }
+        }
+        else
+        {
+            output.push_back(0x78); // DEFLATE, 32K window
+            output.push_back(0x01); // FLEVEL = 0 (fastest)
+
+            if (compression == 0)
+                deflateStored(data, size, output);
+            else
+                deflateFast(data, size, output);
+
+            writeUint32Be(output, adler32(data, size));
+        }
+    }
+
+    // PNG filter heuristics
+    sf::Uint8 paeth(int a, int b, int c)
+    {
+        int p = a + b - c;
+        int pa = std::abs(p - a);
+        int pb = std::abs(p - b);
+        int pc = std::abs(p - c);
+        if ((pa <= pb) && (pa <= pc))
+            return static_cast<sf::Uint8>(a);
+        else if (pb <= pc)
+            return static_cast<sf::Uint8>(b);
+        else
+            return static_cast<sf::Uint8>(c);
+    }
+    void filterRow(int type, const sf::Uint8* row, const sf::Uint8* prior, std::size_t size, sf::Uint8* output)
+    {
+        const std::size_t bpp = 4;
+        switch (type)
+        {
+            case 0: // None
+                std::copy(row, row + size, output);
+                break;
+
+            case 1: // Sub
+                std::copy(row, row + bpp, output);
+                for (std::size_t i = bpp; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - row[i - bpp]);
+                break;
+
+            case 2: // Up
+                for (std::size_t i = 0; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - prior[i]);
+                break;
+
+            case 3: // Average
+                for (std::size_t i = 0; i < bpp; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - (prior[i] >> 1));
+                for (std::size_t i = bpp; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - ((row[i - bpp] + prior[i]) >> 1));
+                break;
+
+            case 4: // Paeth
+                for (std::size_t i = 0; i < bpp; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - prior[i]);
+                for (std::size_t i = bpp; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - paeth(row[i - bpp], prior[i], prior[i - bpp]));
+                break;
+        }
+    }
+
+    // Append a PNG chunk to a buffer
+    void writePngChunk(std::vector<sf::Uint8>& output, const char* type, const sf::Uint8* data, std::size_t size)
+    {
+        writeUint32Be(output, static_cast<sf::Uint32>(size));
+        std::size_t start = output.size();
+        output.insert(output.end(), type, type + 4);
+        if (size > 0)
+            output.insert(output.end(), data, data + size);
+        writeUint32Be(output, crc32(&output[start], size + 4, 0));
+    }
+
+    // libjpeg destination manager that writes to a std::vector
+    struct JpegMemoryDestination
+    {
+        jpeg_destination_mgr    manager;
+        std::vector<sf::Uint8>* output;
+        JOCTET                  buffer[4096];
+    };
+    void initDestination(j_compress_ptr info)
+    {
+        JpegMemoryDestination* destination = reinterpret_cast<JpegMemoryDestination*>(info->dest);
+        destination->manager.next_output_byte = destination->buffer;
+        destination->manager.free_in_buffer = sizeof(destination->buffer);
+    }
+    boolean emptyOutputBuffer(j_compress_ptr info)
+    {
+        JpegMemoryDestination* destination = reinterpret_cast<JpegMemoryDestination*>(info->dest);
+        destination->output->insert(destination->output->end(), destination->buffer, destination->buffer + sizeof(destination->buffer));
+        initDestination(info);
+        return TRUE;
+    }
+    void termDestination(j_compress_ptr info)
+    {
+        JpegMemoryDestination* destination = reinterpret_cast<JpegMemoryDestination*>(info->dest);
+        std::size_t used = sizeof(destination->buffer) - destination->manager.free_in_buffer;
+        destination->output->insert(destination->output->end(), destination->buffer, destination->buffer + used);
+    }
 }
 
 
@@ -85,7 +422,10 @@ ImageLoader& ImageLoader::getInstance()
 ////////////////////////////////////////////////////////////
 ImageLoader::ImageLoader()
 {
-    // Nothing to do
+    // stb_image builds its fixed Huffman tables on first use; build them
+    // now so that images decoded concurrently don't race to initialize them
+    if (!stbi__zdefault_distance[31])
+        stbi__init_zdefaults();
 }
 
 
@@ -220,6 +560,94 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 }
 
 
+////////////////////////////////////////////////////////////
+bool ImageLoader::getImageInfoFromFile(const std::string& filename, Vector2u& size, unsigned int& channelCount)
+{
+    // Parse the header of the file
+    int width, height, channels;
+    if (stbi_info(filename.c_str(), &width, &height, &channels))
+    {
+        size.x = width;
+        size.y = height;
+        channelCount = channels;
+
+        return true;
+    }
+    else
+    {
+        // Error, unknown or corrupt file
+        err() << "Failed to read image info \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
+
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::getImageInfoFromMemory(const void* data, std::size_t dataSize, Vector2u& size, unsigned int& channelCount)
+{
+    // Check input parameters
+    if (data && dataSize)
+    {
+        // Parse the header of the file
+        int width, height, channels;
+        const unsigned char* buffer = static_cast<const unsigned char*>(data);
+        if (stbi_info_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels))
+        {
+            size.x = width;
+            size.y = height;
+            channelCount = channels;
+
+            return true;
+        }
+        else
+        {
+            // Error, unknown or corrupt file
+            err() << "Failed to read image info from memory. Reason: " << stbi_failure_reason() << std::endl;
+
+            return false;
+        }
+    }
+    else
+    {
+        err() << "Failed to read image info from memory, no data provided" << std::endl;
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::getImageInfoFromStream(InputStream& stream, Vector2u& size, unsigned int& channelCount)
+{
+    // Make sure that the stream's reading position is at the beginning
+    stream.seek(0);
+
+    // Setup the stb_image callbacks
+    stbi_io_callbacks callbacks;
+    callbacks.read = &read;
+    callbacks.skip = &skip;
+    callbacks.eof  = &eof;
+
+    // Parse the header of the file
+    int width, height, channels;
+    if (stbi_info_from_callbacks(&callbacks, &stream, &width, &height, &channels))
+    {
+        size.x = width;
+        size.y = height;
+        channelCount = channels;
+
+        return true;
+    }
+    else
+    {
+        // Error, unknown or corrupt file
+        err() << "Failed to read image info from stream. Reason: " << stbi_failure_reason() << std::endl;
+
+        return false;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
 {
@@ -263,28 +691,165 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
 }
 
 
+////////////////////////////////////////////////////////////
+bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size, unsigned int compression, unsigned int quality)
+{
+    // Make sure the image is not empty
+    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
+    {
+        output.clear();
+
+        const std::string specified = toLower(format);
+
+        if (specified == "bmp")
+        {
+            // BMP format
+            encodeBmp(output, pixels, size.x, size.y);
+            return true;
+        }
+        else if (specified == "tga")
+        {
+            // TGA format
+            if (encodeTga(output, pixels, size.x, size.y))
+                return true;
+        }
+        else if (specified == "png")
+        {
+            // PNG format
+            if (encodePng(output, pixels, size.x, size.y, std::min(compression, 9u)))
+                return true;
+        }
+        else if (specified == "jpg" || specified == "jpeg")
+        {
+            // JPG format
+            if (encodeJpg(output, pixels, size.x, size.y, std::max(1u, std::min(quality, 100u))))
+                return true;
+        }
+    }
+
+    err() << "Failed to save image with format \"" << format << "\"" << std::endl;
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
 {
-    // Open the file to write in
+    // Encode the image in memory
+    std::vector<Uint8> buffer;
+    if (!encodeJpg(buffer, pixels, width, height, 90))
+        return false;
+
+    // Write it to the file
     FILE* file = fopen(filename.c_str(), "wb");
     if (!file)
         return false;
 
+    bool written = fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size();
+
+    // Close the file
+    fclose(file);
+
+    return written;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::encodePng(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, unsigned int compression)
+{
+    const std::size_t rowSize = width * 4;
+
+    // Filter each row; the row above the first one is considered as all zeros
+    std::vector<Uint8> filtered((rowSize + 1) * height);
+    std::vector<Uint8> zeros(rowSize, 0);
+    std::vector<Uint8> candidate(rowSize);
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        const Uint8* row   = &pixels[y * rowSize];
+        const Uint8* prior = y > 0 ? row - rowSize : &zeros[0];
+        Uint8*       dest  = &filtered[y * (rowSize + 1)];
+
+        if (compression >= 2)
+        {
+            // Try the filters and keep the one that gives the smallest sum of absolute differences;
+            // the fast mode only tries the cheap ones
+            int filterCount = compression >= 4 ? 5 : 3;
+            unsigned long bestSum = 0;
+            for (int type = 0; type < filterCount; ++type)
+            {
+                filterRow(type, row, prior, rowSize, &candidate[0]);
+
+                unsigned long sum = 0;
+                for (std::size_t i = 0; i < rowSize; ++i)
+                    sum += std::abs(static_cast<int>(static_cast<signed char>(candidate[i])));
+
+                if ((type == 0) || (sum < bestSum))
+                {
+                    bestSum = sum;
+                    dest[0] = static_cast<Uint8>(type);
+                    std::copy(candidate.begin(), candidate.end(), dest + 1);
+                }
+            }
+        }
+        else
+        {
+            // No filter for stored data, always "up" otherwise
+            int type = compression == 0 ? 0 : 2;
+            dest[0] = static_cast<Uint8>(type);
+            filterRow(type, row, prior, rowSize, dest + 1);
+        }
+    }
+
+    // Compress the filtered data
+    std::vector<Uint8> compressed;
+    zlibCompress(&filtered[0], filtered.size(), compression, compressed);
+    if (compressed.empty())
+        return false;
+
+    // Write the signature and the chunks
+    static const Uint8 signature[] = {137, 80, 78, 71, 13, 10, 26, 10};
+    output.insert(output.end(), signature, signature + sizeof(signature));
+
+    std::vector<Uint8> header;
+    writeUint32Be(header, width);
+    writeUint32Be(header, height);
+    header.push_back(8); // bit depth
+    header.push_back(6); // color type: RGBA
+    header.push_back(0); // compression method
+    header.push_back(0); // filter method
+    header.push_back(0); // interlace method
+    writePngChunk(output, "IHDR", &header[0], header.size());
+    writePngChunk(output, "IDAT", &compressed[0], compressed.size());
+    writePngChunk(output, "IEND", NULL, 0);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::encodeJpg(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, unsigned int quality)
+{
     // Initialize the error handler
     jpeg_compress_struct compressInfos;
     jpeg_error_mgr errorManager;
     compressInfos.err = jpeg_std_error(&errorManager);
 
+    // Setup the destination manager that writes to the output buffer
+    JpegMemoryDestination destination;
+    destination.manager.init_destination = &initDestination;
+    destination.manager.empty_output_buffer = &emptyOutputBuffer;
+    destination.manager.term_destination = &termDestination;
+    destination.output = &output;
+
     // Initialize all the writing and compression infos
     jpeg_create_compress(&compressInfos);
     compressInfos.image_width      = width;
     compressInfos.image_height     = height;
     compressInfos.input_components = 3;
     compressInfos.in_color_space   = JCS_RGB;
-    jpeg_stdio_dest(&compressInfos, file);
+    compressInfos.dest             = &destination.manager;
     jpeg_set_defaults(&compressInfos);
-    jpeg_set_quality(&compressInfos, 90, TRUE);
+    jpeg_set_quality(&compressInfos, quality, TRUE);
 
     // Get rid of the alpha channel
     std::vector<Uint8> buffer(width * height * 3);
@@ -310,8 +875,86 @@ bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>
     jpeg_finish_compress(&compressInfos);
     jpeg_destroy_compress(&compressInfos);
 
-    // Close the file
-    fclose(file);
+    return !output.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageLoader::encodeBmp(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
+{
+    // 24 bits per pixel, rows are padded to 4 bytes
+    const std::size_t padding = (4 - (width * 3) % 4) % 4;
+    const Uint32 dataSize = static_cast<Uint32>((width * 3 + padding) * height);
+
+    output.reserve(54 + dataSize);
+
+    // File header
+    output.push_back('B');
+    output.push_back('M');
+    writeUint32Le(output, 54 + dataSize);
+    writeUint32Le(output, 0);
+    writeUint32Le(output, 54);
+
+    // Info header
+    writeUint32Le(output, 40);
+    writeUint32Le(output, width);
+    writeUint32Le(output, height);
+    writeUint16Le(output, 1);
+    writeUint16Le(output, 24);
+    writeUint32Le(output, 0);
+    writeUint32Le(output, dataSize);
+    writeUint32Le(output, 0);
+    writeUint32Le(output, 0);
+    writeUint32Le(output, 0);
+    writeUint32Le(output, 0);
+
+    // Pixels, bottom-up in BGR order
+    for (std::size_t y = height; y > 0; --y)
+    {
+        const Uint8* row = &pixels[(y - 1) * width * 4];
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            output.push_back(row[x * 4 + 2]);
+            output.push_back(row[x * 4 + 1]);
+            output.push_back(row[x * 4 + 0]);
+        }
+        output.insert(output.end(), padding, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::encodeTga(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
+{
+    // The header stores the dimensions on 16 bits
+    if ((width > 65535) || (height > 65535))
+    {
+        err() << "Failed to encode image in TGA format, its size (" << width << "x" << height << ") exceeds 65535 pixels" << std::endl;
+        return false;
+    }
+
+    output.reserve(18 + width * height * 4);
+
+    // Header: uncompressed true-color image, 32 bits per pixel, top-left origin
+    output.push_back(0);
+    output.push_back(0);
+    output.push_back(2);
+    output.insert(output.end(), 5, 0);
+    writeUint16Le(output, 0);
+    writeUint16Le(output, 0);
+    writeUint16Le(output, width);
+    writeUint16Le(output, height);
+    output.push_back(32);
+    output.push_back(0x28);
+
+    // Pixels in BGRA order
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        output.push_back(pixels[i + 2]);
+        output.push_back(pixels[i + 1]);
+        output.push_back(pixels[i + 0]);
+        output.push_back(pixels[i + 3]);
+    }
 
     return true;
 }
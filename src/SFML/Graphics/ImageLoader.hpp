@@ -93,6 +93,49 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the size and channel count of an image file on disk
+    ///
+    /// Only the header of the file is parsed, pixels are not decoded.
+    ///
+    /// \param filename     Path of image file to probe
+    /// \param size         Size of the image, in pixels
+    /// \param channelCount Number of color channels stored in the file
+    ///
+    /// \return True if the header could be read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getImageInfoFromFile(const std::string& filename, Vector2u& size, unsigned int& channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the size and channel count of an image file in memory
+    ///
+    /// Only the header of the file is parsed, pixels are not decoded.
+    ///
+    /// \param data         Pointer to the file data in memory
+    /// \param dataSize     Size of the data, in bytes
+    /// \param size         Size of the image, in pixels
+    /// \param channelCount Number of color channels stored in the file
+    ///
+    /// \return True if the header could be read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getImageInfoFromMemory(const void* data, std::size_t dataSize, Vector2u& size, unsigned int& channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the size and channel count of an image from a custom stream
+    ///
+    /// Only the header of the file is parsed, pixels are not decoded.
+    ///
+    /// \param stream       Source stream to read from
+    /// \param size         Size of the image, in pixels
+    /// \param channelCount Number of color channels stored in the file
+    ///
+    /// \return True if the header could be read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getImageInfoFromStream(InputStream& stream, Vector2u& size, unsigned int& channelCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
     ///
@@ -105,6 +148,21 @@ public:
     ////////////////////////////////////////////////////////////
     bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an array of pixels as an image file in memory
+    ///
+    /// \param format      Format of the image to encode ("png", "jpg", "bmp" or "tga")
+    /// \param output      Buffer to fill with the encoded file data
+    /// \param pixels      Array of pixels to encode
+    /// \param size        Size of image to encode, in pixels
+    /// \param compression PNG compression level, from 0 (fastest) to 9 (smallest)
+    /// \param quality     JPEG quality, from 1 to 100
+    ///
+    /// \return True if encoding was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveImageToMemory(const std::string& format, std::vector<Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size, unsigned int compression, unsigned int quality);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -131,6 +189,58 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     bool writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an image in PNG format in memory
+    ///
+    /// \param output      Buffer to fill with the encoded file data
+    /// \param pixels      Array of pixels to encode
+    /// \param width       Width of image to encode, in pixels
+    /// \param height      Height of image to encode, in pixels
+    /// \param compression Compression level, from 0 (fastest) to 9 (smallest)
+    ///
+    /// \return True if encoding was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool encodePng(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, unsigned int compression);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an image in JPEG format in memory
+    ///
+    /// \param output  Buffer to fill with the encoded file data
+    /// \param pixels  Array of pixels to encode
+    /// \param width   Width of image to encode, in pixels
+    /// \param height  Height of image to encode, in pixels
+    /// \param quality Quality of the compression, from 1 to 100
+    ///
+    /// \return True if encoding was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool encodeJpg(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, unsigned int quality);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an image in BMP format in memory
+    ///
+    /// \param output Buffer to fill with the encoded file data
+    /// \param pixels Array of pixels to encode
+    /// \param width  Width of image to encode, in pixels
+    /// \param height Height of image to encode, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void encodeBmp(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode an image in TGA format in memory
+    ///
+    /// \param output Buffer to fill with the encoded file data
+    /// \param pixels Array of pixels to encode
+    /// \param width  Width of image to encode, in pixels
+    /// \param height Height of image to encode, in pixels
+    ///
+    /// \return True if encoding was successful, false if the image is too large for the format
+    ///
+    ////////////////////////////////////////////////////////////
+    bool encodeTga(std::vector<Uint8>& output, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
 };
 
 } // namespace priv
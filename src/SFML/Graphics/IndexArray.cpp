@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/IndexArray.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+IndexArray::IndexArray() :
+m_indices16(),
+m_indices32(),
+m_32Bits   (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexArray::IndexArray(std::size_t indexCount) :
+m_indices16(indexCount, 0),
+m_indices32(),
+m_32Bits   (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t IndexArray::getIndexCount() const
+{
+    return m_32Bits ? m_indices32.size() : m_indices16.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 IndexArray::operator [](std::size_t position) const
+{
+    return m_32Bits ? m_indices32[position] : m_indices16[position];
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexArray::setIndex(std::size_t position, Uint32 value)
+{
+    if (!m_32Bits && (value > 0xFFFF))
+        convertTo32Bits();
+
+    if (m_32Bits)
+        m_indices32[position] = value;
+    else
+        m_indices16[position] = static_cast<Uint16>(value);
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexArray::clear()
+{
+    m_indices16.clear();
+    m_indices32.clear();
+    m_32Bits = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexArray::resize(std::size_t indexCount)
+{
+    if (m_32Bits)
+    {
+        bool shrinking = indexCount < m_indices32.size();
+        m_indices32.resize(indexCount, 0);
+
+        // The large indices may have been removed
+        if (shrinking)
+            convertTo16BitsIfPossible();
+    }
+    else
+    {
+        m_indices16.resize(indexCount, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexArray::append(Uint32 value)
+{
+    if (!m_32Bits && (value > 0xFFFF))
+        convertTo32Bits();
+
+    if (m_32Bits)
+        m_indices32.push_back(value);
+    else
+        m_indices16.push_back(static_cast<Uint16>(value));
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexArray::appendQuad(Uint32 first)
+{
+    append(first + 0);
+    append(first + 1);
+    append(first + 2);
+    append(first + 2);
+    append(first + 1);
+    append(first + 3);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexArray::is32Bits() const
+{
+    return m_32Bits;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexArray::convertTo32Bits()
+{
+    m_indices32.assign(m_indices16.begin(), m_indices16.end());
+    m_indices16.clear();
+    m_32Bits = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexArray::convertTo16BitsIfPossible()
+{
+    for (std::vector<Uint32>::const_iterator it = m_indices32.begin(); it != m_indices32.end(); ++it)
+    {
+        if (*it > 0xFFFF)
+            return;
+    }
+
+    m_indices16.assign(m_indices32.begin(), m_indices32.end());
+    m_indices32.clear();
+    m_32Bits = false;
+}
+
+} // namespace sf
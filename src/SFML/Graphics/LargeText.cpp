@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/LargeText.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Number of lines whose geometry is generated and cached together
+    const std::size_t linesPerChunk = 32;
+
+    // Number of chunks kept in the cache on each side of the visible ones
+    const std::size_t chunkCacheMargin = 2;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+LargeText::LargeText() :
+m_string          (),
+m_font            (NULL),
+m_characterSize   (30),
+m_style           (Text::Regular),
+m_color           (255, 255, 255),
+m_lineStarts      (1, 0),
+m_chunks          (),
+m_bounds          (),
+m_boundsNeedUpdate(true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+LargeText::LargeText(const String& string, const Font& font, unsigned int characterSize) :
+m_string          (),
+m_font            (&font),
+m_characterSize   (characterSize),
+m_style           (Text::Regular),
+m_color           (255, 255, 255),
+m_lineStarts      (1, 0),
+m_chunks          (),
+m_bounds          (),
+m_boundsNeedUpdate(true)
+{
+    setString(string);
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeText::setString(const String& string)
+{
+    m_string = string;
+
+    // Find the beginning of each line
+    m_lineStarts.assign(1, 0);
+    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    {
+        if (m_string[i] == '\n')
+            m_lineStarts.push_back(i + 1);
+    }
+
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeText::setFont(const Font& font)
+{
+    if (m_font != &font)
+    {
+        m_font = &font;
+        invalidate();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeText::setCharacterSize(unsigned int size)
+{
+    if (m_characterSize != size)
+    {
+        m_characterSize = size;
+        invalidate();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeText::setStyle(Uint32 style)
+{
+    if (m_style != style)
+    {
+        m_style = style;
+        invalidate();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeText::setColor(const Color& color)
+{
+    if (color != m_color)
+    {
+        m_color = color;
+
+        // Change the colors of the cached vertices directly
+        for (ChunkTable::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        {
+            for (std::size_t i = 0; i < it->second.getVertexCount(); ++i)
+                it->second[i].color = m_color;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const String& LargeText::getString() const
+{
+    return m_string;
+}
+
+
+////////////////////////////////////////////////////////////
+const Font* LargeText::getFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int LargeText::getCharacterSize() const
+{
+    return m_characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 LargeText::getStyle() const
+{
+    return m_style;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& LargeText::getColor() const
+{
+    return m_color;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t LargeText::getLineCount() const
+{
+    return m_lineStarts.size();
+}
+
+
+////////////////////////////////////////////////////////////
+float LargeText::getLineTop(std::size_t line) const
+{
+    if (!m_font)
+        return 0.f;
+
+    return static_cast<float>(line) * m_font->getLineSpacing(m_characterSize);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect LargeText::getLocalBounds() const
+{
+    if (m_boundsNeedUpdate)
+    {
+        m_boundsNeedUpdate = false;
+        m_bounds = FloatRect();
+
+        if (m_font)
+        {
+            bool  bold   = (m_style & Text::Bold) != 0;
+            float hspace = m_font->getGlyph(L' ', m_characterSize, bold).advance;
+
+            // Find the longest line
+            float width = 0.f;
+            float x = 0.f;
+            Uint32 prevChar = 0;
+            for (std::size_t i = 0; i < m_string.getSize(); ++i)
+            {
+                Uint32 curChar = m_string[i];
+                x += m_font->getKerning(prevChar, curChar, m_characterSize);
+                prevChar = curChar;
+
+                switch (curChar)
+                {
+                    case ' ':  x += hspace;                                                  break;
+                    case '\t': x += hspace * 4;                                              break;
+                    case '\n': x = 0;                                                        break;
+                    default:   x += m_font->getGlyph(curChar, m_characterSize, bold).advance; break;
+                }
+
+                width = std::max(width, x);
+            }
+
+            m_bounds.width  = width;
+            m_bounds.height = getLineTop(m_lineStarts.size());
+        }
+    }
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect LargeText::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeText::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_font || m_string.isEmpty())
+        return;
+
+    states.transform *= getTransform();
+
+    // Compute the area of the view in local coordinates
+    const View& view = target.getView();
+    FloatRect viewArea = view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    FloatRect area = states.transform.getInverse().transformRect(viewArea);
+
+    // Find the range of visible chunks; glyphs may overflow their line
+    // by about a line height, so one more line is included on each side
+    float lineSpacing = m_font->getLineSpacing(m_characterSize);
+    if (lineSpacing <= 0.f)
+        return;
+    float firstLine = std::floor(area.top / lineSpacing) - 1.f;
+    float lastLine  = std::ceil((area.top + area.height) / lineSpacing) + 1.f;
+    if ((lastLine < 0.f) || (firstLine >= static_cast<float>(m_lineStarts.size())))
+        return;
+
+    std::size_t chunkCount = (m_lineStarts.size() + linesPerChunk - 1) / linesPerChunk;
+    std::size_t firstChunk = firstLine > 0.f ? static_cast<std::size_t>(firstLine) / linesPerChunk : 0;
+    std::size_t lastChunk  = std::min(static_cast<std::size_t>(lastLine) / linesPerChunk, chunkCount - 1);
+
+    // Drop the cached chunks which are too far from the view
+    ChunkTable::iterator it = m_chunks.begin();
+    while (it != m_chunks.end())
+    {
+        if ((it->first + chunkCacheMargin < firstChunk) || (it->first > lastChunk + chunkCacheMargin))
+            m_chunks.erase(it++);
+        else
+            ++it;
+    }
+
+    // Generate the missing visible chunks, and draw them
+    states.texture = &m_font->getTexture(m_characterSize);
+    for (std::size_t chunk = firstChunk; chunk <= lastChunk; ++chunk)
+    {
+        ChunkTable::iterator found = m_chunks.find(chunk);
+        if (found == m_chunks.end())
+        {
+            found = m_chunks.insert(std::make_pair(chunk, VertexArray(Triangles))).first;
+            buildChunk(chunk, found->second);
+        }
+
+        if (found->second.getVertexCount() > 0)
+            target.draw(found->second, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeText::buildChunk(std::size_t chunk, VertexArray& vertices) const
+{
+    // Compute values related to the text style
+    bool  bold   = (m_style & Text::Bold) != 0;
+    float italic = (m_style & Text::Italic) ? 0.208f : 0.f; // 12 degrees
+
+    // Precompute the variables needed by the algorithm
+    float hspace = m_font->getGlyph(L' ', m_characterSize, bold).advance;
+    float vspace = m_font->getLineSpacing(m_characterSize);
+
+    std::size_t firstLine = chunk * linesPerChunk;
+    std::size_t lastLine  = std::min(firstLine + linesPerChunk, m_lineStarts.size());
+    for (std::size_t line = firstLine; line < lastLine; ++line)
+    {
+        std::size_t begin = m_lineStarts[line];
+        std::size_t end   = (line + 1 < m_lineStarts.size()) ? m_lineStarts[line + 1] - 1 : m_string.getSize();
+
+        float  x        = 0.f;
+        float  y        = static_cast<float>(m_characterSize) + vspace * line;
+        Uint32 prevChar = (line > 0) ? '\n' : 0;
+
+        // Create one quad for each character of the line
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            Uint32 curChar = m_string[i];
+
+            // Apply the kerning offset
+            x += m_font->getKerning(prevChar, curChar, m_characterSize);
+            prevChar = curChar;
+
+            // Handle special characters
+            if (curChar == ' ')
+            {
+                x += hspace;
+                continue;
+            }
+            if (curChar == '\t')
+            {
+                x += hspace * 4;
+                continue;
+            }
+
+            // Extract the current glyph's description
+            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
+
+            float left   = glyph.bounds.left;
+            float top    = glyph.bounds.top;
+            float right  = glyph.bounds.left + glyph.bounds.width;
+            float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+            float u1 = static_cast<float>(glyph.textureRect.left);
+            float v1 = static_cast<float>(glyph.textureRect.top);
+            float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+            float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
+
+            // Add a quad for the current character
+            vertices.append(Vertex(Vector2f(x + left  - italic * top,    y + top),    m_color, Vector2f(u1, v1)));
+            vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
+            vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
+            vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
+            vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
+            vertices.append(Vertex(Vector2f(x + right - italic * bottom, y + bottom), m_color, Vector2f(u2, v2)));
+
+            // Advance to the next character
+            x += glyph.advance;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeText::invalidate()
+{
+    m_chunks.clear();
+    m_boundsNeedUpdate = true;
+}
+
+} // namespace sf
@@ -0,0 +1,643 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Number of entries of the color table
+    const std::size_t colorRampSize = 256;
+
+    // 16-bit indices can address 16384 squares of 4 vertices
+    const std::size_t squaresPerBatch = 16384;
+
+    // Minimum number of particles handled by each thread
+    const std::size_t particlesPerThread = 16384;
+
+    const float pi = 3.141592654f;
+
+    // Kernel processing a contiguous range of particles
+    struct ParticleKernel
+    {
+        void integrate()
+        {
+            // Plain loops over separate arrays, which compilers vectorize
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                float vx = velocitiesX[i] * dragFactor + deltaVelocityX;
+                float vy = velocitiesY[i] * dragFactor + deltaVelocityY;
+                velocitiesX[i] = vx;
+                velocitiesY[i] = vy;
+                positionsX[i] += vx * elapsed;
+                positionsY[i] += vy * elapsed;
+            }
+
+            for (std::size_t i = begin; i < end; ++i)
+                ages[i] += ageRates[i] * elapsed;
+        }
+
+        void integrateAndWrite()
+        {
+            integrate();
+            write();
+        }
+
+        void write()
+        {
+            if (halfSize > 0.f)
+                writeSquares();
+            else
+                writePoints();
+        }
+
+        void writePoints()
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                sf::Vertex& vertex = vertices[i];
+                vertex.position.x = positionsX[i];
+                vertex.position.y = positionsY[i];
+                vertex.color = getColor(ages[i]);
+            }
+        }
+
+        void writeSquares()
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                float left   = positionsX[i] - halfSize;
+                float top    = positionsY[i] - halfSize;
+                float right  = positionsX[i] + halfSize;
+                float bottom = positionsY[i] + halfSize;
+                sf::Color color = getColor(ages[i]);
+
+                sf::Vertex* square = vertices + i * 4;
+                square[0].position.x = left;  square[0].position.y = top;    square[0].color = color;
+                square[1].position.x = right; square[1].position.y = top;    square[1].color = color;
+                square[2].position.x = left;  square[2].position.y = bottom; square[2].color = color;
+                square[3].position.x = right; square[3].position.y = bottom; square[3].color = color;
+            }
+        }
+
+        sf::Color getColor(float age) const
+        {
+            std::size_t index = static_cast<std::size_t>(age * (colorRampSize - 1));
+            return colorRamp[std::min(index, colorRampSize - 1)];
+        }
+
+        void run()
+        {
+            (this->*step)();
+        }
+
+        void (ParticleKernel::*step)();
+        std::size_t      begin;
+        std::size_t      end;
+        float*           positionsX;
+        float*           positionsY;
+        float*           velocitiesX;
+        float*           velocitiesY;
+        float*           ages;
+        const float*     ageRates;
+        sf::Vertex*      vertices;
+        const sf::Color* colorRamp;
+        float            elapsed;
+        float            dragFactor;
+        float            deltaVelocityX;
+        float            deltaVelocityY;
+        float            halfSize;
+    };
+
+    // Run a kernel step on a range of particles, split across several threads if worth it.
+    // The threads are started for each call rather than kept waiting between frames: SFML has
+    // no condition variable to put idle workers to sleep, and polling would cost more than the
+    // launch itself (about 15 us per thread, against several milliseconds of work per chunk
+    // since each one processes at least particlesPerThread particles)
+    void runKernel(ParticleKernel kernel, std::size_t first, std::size_t count, unsigned int threadCount)
+    {
+        std::size_t chunks = std::min<std::size_t>(std::max(threadCount, 1u), count / particlesPerThread);
+        if (chunks <= 1)
+        {
+            kernel.begin = first;
+            kernel.end = first + count;
+            kernel.run();
+            return;
+        }
+
+        // The calling thread processes the first chunk
+        std::vector<ParticleKernel> kernels(chunks, kernel);
+        std::vector<sf::Thread*> threads(chunks, NULL);
+        for (std::size_t i = 0; i < chunks; ++i)
+        {
+            kernels[i].begin = first + count * i / chunks;
+            kernels[i].end   = first + count * (i + 1) / chunks;
+            if (i > 0)
+            {
+                threads[i] = new sf::Thread(&ParticleKernel::run, &kernels[i]);
+                threads[i]->launch();
+            }
+        }
+
+        kernels[0].run();
+
+        for (std::size_t i = 1; i < chunks; ++i)
+        {
+            threads[i]->wait();
+            delete threads[i];
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem(std::size_t capacity) :
+m_positionsX     (),
+m_positionsY     (),
+m_velocitiesX    (),
+m_velocitiesY    (),
+m_ages           (),
+m_ageRates       (),
+m_particleCount  (0),
+m_vertices       (),
+m_indices        (),
+m_drawCount      (0),
+m_emitterPosition(0, 0),
+m_emitterSize    (0, 0),
+m_emissionRate   (0),
+m_emissionDebt   (0),
+m_speed          (0),
+m_speedSpread    (0),
+m_angle          (0),
+m_angleSpread    (0),
+m_minLifetime    (1),
+m_maxLifetime    (1),
+m_gravity        (0, 0),
+m_drag           (0),
+m_colorRamp      (colorRampSize, Color::White),
+m_particleSize   (0),
+m_texture        (NULL),
+m_textureRect    (),
+m_threadCount    (1),
+m_random         (0x9E3779B9)
+{
+    setCapacity(capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setCapacity(std::size_t capacity)
+{
+    m_positionsX.resize(capacity);
+    m_positionsY.resize(capacity);
+    m_velocitiesX.resize(capacity);
+    m_velocitiesY.resize(capacity);
+    m_ages.resize(capacity);
+    m_ageRates.resize(capacity);
+    m_particleCount = std::min(m_particleCount, capacity);
+
+    updateLayout();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getCapacity() const
+{
+    return m_ages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getParticleCount() const
+{
+    return m_particleCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setEmitterPosition(const Vector2f& position)
+{
+    m_emitterPosition = position;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getEmitterPosition() const
+{
+    return m_emitterPosition;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setEmitterSize(const Vector2f& size)
+{
+    m_emitterSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getEmitterSize() const
+{
+    return m_emitterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setEmissionRate(float rate)
+{
+    m_emissionRate = std::max(rate, 0.f);
+}
+
+
+////////////////////////////////////////////////////////////
+float ParticleSystem::getEmissionRate() const
+{
+    return m_emissionRate;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setParticleVelocity(const Vector2f& velocity, float angleSpread, float speedSpread)
+{
+    m_speed       = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    m_speedSpread = speedSpread;
+    m_angle       = std::atan2(velocity.y, velocity.x);
+    m_angleSpread = angleSpread * pi / 180.f;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setParticleLifetime(Time minimum, Time maximum)
+{
+    m_minLifetime = minimum.asSeconds();
+    m_maxLifetime = std::max(maximum.asSeconds(), m_minLifetime);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setGravity(const Vector2f& acceleration)
+{
+    m_gravity = acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getGravity() const
+{
+    return m_gravity;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setDrag(float drag)
+{
+    m_drag = drag;
+}
+
+
+////////////////////////////////////////////////////////////
+float ParticleSystem::getDrag() const
+{
+    return m_drag;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setColorRamp(const Color& start, const Color& end)
+{
+    std::vector<Color> colors(2);
+    colors[0] = start;
+    colors[1] = end;
+    setColorRamp(colors);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setColorRamp(const std::vector<Color>& colors)
+{
+    if (colors.empty())
+        return;
+
+    // Sample the ramp into the color table, interpolating linearly between the colors
+    for (std::size_t i = 0; i < colorRampSize; ++i)
+    {
+        float position = static_cast<float>(i) / (colorRampSize - 1) * (colors.size() - 1);
+        std::size_t first = std::min(static_cast<std::size_t>(position), colors.size() - 1);
+        std::size_t second = std::min(first + 1, colors.size() - 1);
+        float factor = position - first;
+
+        const Color& a = colors[first];
+        const Color& b = colors[second];
+        m_colorRamp[i] = Color(static_cast<Uint8>(a.r + (b.r - a.r) * factor + 0.5f),
+                               static_cast<Uint8>(a.g + (b.g - a.g) * factor + 0.5f),
+                               static_cast<Uint8>(a.b + (b.b - a.b) * factor + 0.5f),
+                               static_cast<Uint8>(a.a + (b.a - a.a) * factor + 0.5f));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setParticleSize(float size)
+{
+    bool layoutChanged = (size > 0.f) != (m_particleSize > 0.f);
+    m_particleSize = std::max(size, 0.f);
+
+    if (layoutChanged)
+        updateLayout();
+    else
+        updateVertices();
+}
+
+
+////////////////////////////////////////////////////////////
+float ParticleSystem::getParticleSize() const
+{
+    return m_particleSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTexture(const Texture* texture, bool resetRect)
+{
+    // Recompute the texture area if requested, or if there was no texture & rect before
+    if (texture && (resetRect || (!m_texture && (m_textureRect == IntRect()))))
+    {
+        Vector2u size = texture->getSize();
+        setTextureRect(IntRect(0, 0, size.x, size.y));
+    }
+
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTextureRect(const IntRect& rect)
+{
+    if (rect != m_textureRect)
+    {
+        m_textureRect = rect;
+        updateLayout();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* ParticleSystem::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& ParticleSystem::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setThreadCount(unsigned int count)
+{
+    m_threadCount = std::max(count, 1u);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ParticleSystem::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::emit(std::size_t count)
+{
+    count = std::min(count, getCapacity() - m_particleCount);
+
+    for (std::size_t i = m_particleCount; i < m_particleCount + count; ++i)
+    {
+        float angle    = m_angle + (random() - 0.5f) * m_angleSpread;
+        float speed    = m_speed + (random() * 2.f - 1.f) * m_speedSpread;
+        float lifetime = m_minLifetime + random() * (m_maxLifetime - m_minLifetime);
+
+        m_positionsX[i]  = m_emitterPosition.x + (random() - 0.5f) * m_emitterSize.x;
+        m_positionsY[i]  = m_emitterPosition.y + (random() - 0.5f) * m_emitterSize.y;
+        m_velocitiesX[i] = std::cos(angle) * speed;
+        m_velocitiesY[i] = std::sin(angle) * speed;
+        m_ages[i]        = 0.f;
+        m_ageRates[i]    = lifetime > 0.f ? 1.f / lifetime : 1e9f;
+    }
+
+    m_particleCount += count;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::update(Time elapsed)
+{
+    float seconds = elapsed.asSeconds();
+
+    // Move and age the particles, and write their vertices in the same pass
+    // so that the threads are only started once per update
+    if (m_particleCount > 0)
+    {
+        ParticleKernel kernel = ParticleKernel();
+        kernel.step           = &ParticleKernel::integrateAndWrite;
+        kernel.positionsX     = &m_positionsX[0];
+        kernel.positionsY     = &m_positionsY[0];
+        kernel.velocitiesX    = &m_velocitiesX[0];
+        kernel.velocitiesY    = &m_velocitiesY[0];
+        kernel.ages           = &m_ages[0];
+        kernel.ageRates       = &m_ageRates[0];
+        kernel.vertices       = &m_vertices[0];
+        kernel.colorRamp      = &m_colorRamp[0];
+        kernel.elapsed        = seconds;
+        kernel.dragFactor     = std::exp(-m_drag * seconds);
+        kernel.deltaVelocityX = m_gravity.x * seconds;
+        kernel.deltaVelocityY = m_gravity.y * seconds;
+        kernel.halfSize       = m_particleSize / 2.f;
+        runKernel(kernel, 0, m_particleCount, m_threadCount);
+    }
+
+    // Remove the dead particles, by moving the last ones in their place
+    std::size_t i = 0;
+    while (i < m_particleCount)
+    {
+        if (m_ages[i] >= 1.f)
+        {
+            std::size_t last = --m_particleCount;
+            m_positionsX[i]  = m_positionsX[last];
+            m_positionsY[i]  = m_positionsY[last];
+            m_velocitiesX[i] = m_velocitiesX[last];
+            m_velocitiesY[i] = m_velocitiesY[last];
+            m_ages[i]        = m_ages[last];
+            m_ageRates[i]    = m_ageRates[last];
+
+            // Move the vertices too, they are already up to date
+            std::size_t verticesPerParticle = (m_particleSize > 0.f) ? 4 : 1;
+            for (std::size_t j = 0; j < verticesPerParticle; ++j)
+                m_vertices[i * verticesPerParticle + j] = m_vertices[last * verticesPerParticle + j];
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    // Emit the new particles
+    m_emissionDebt += m_emissionRate * seconds;
+    std::size_t count = static_cast<std::size_t>(m_emissionDebt);
+    m_emissionDebt -= count;
+    std::size_t firstNew = m_particleCount;
+    emit(count);
+
+    // Only the new particles still need their vertices
+    updateVertices(firstNew);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::clear()
+{
+    m_particleCount = 0;
+    m_drawCount = 0;
+    m_emissionDebt = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_drawCount == 0)
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    if (m_particleSize > 0.f)
+    {
+        // Draw the squares by batches which all share the same indices
+        for (std::size_t first = 0; first < m_drawCount; first += squaresPerBatch)
+        {
+            std::size_t count = std::min(squaresPerBatch, m_drawCount - first);
+            target.draw(&m_vertices[first * 4], count * 4, &m_indices[0], count * 6, Triangles, states);
+        }
+    }
+    else
+    {
+        target.draw(&m_vertices[0], m_drawCount, Points, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::updateLayout()
+{
+    float left   = static_cast<float>(m_textureRect.left);
+    float top    = static_cast<float>(m_textureRect.top);
+    float right  = left + m_textureRect.width;
+    float bottom = top + m_textureRect.height;
+
+    if (m_particleSize > 0.f)
+    {
+        // Squares: 4 vertices per particle, textured with the whole texture rect
+        m_vertices.resize(getCapacity() * 4);
+        for (std::size_t i = 0; i < m_vertices.size(); i += 4)
+        {
+            m_vertices[i + 0].texCoords = Vector2f(left, top);
+            m_vertices[i + 1].texCoords = Vector2f(right, top);
+            m_vertices[i + 2].texCoords = Vector2f(left, bottom);
+            m_vertices[i + 3].texCoords = Vector2f(right, bottom);
+        }
+
+        // Two triangles per square, in the same order as IndexArray::appendQuad
+        std::size_t squares = std::min(getCapacity(), squaresPerBatch);
+        m_indices.resize(squares * 6);
+        for (std::size_t i = 0; i < squares; ++i)
+        {
+            Uint16 first = static_cast<Uint16>(i * 4);
+            m_indices[i * 6 + 0] = first + 0;
+            m_indices[i * 6 + 1] = first + 1;
+            m_indices[i * 6 + 2] = first + 2;
+            m_indices[i * 6 + 3] = first + 2;
+            m_indices[i * 6 + 4] = first + 1;
+            m_indices[i * 6 + 5] = first + 3;
+        }
+    }
+    else
+    {
+        // Points: 1 vertex per particle
+        m_vertices.resize(getCapacity());
+        for (std::size_t i = 0; i < m_vertices.size(); ++i)
+            m_vertices[i].texCoords = Vector2f(left, top);
+
+        m_indices.clear();
+    }
+
+    updateVertices();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::updateVertices(std::size_t first)
+{
+    m_drawCount = m_particleCount;
+    if (first >= m_drawCount)
+        return;
+
+    ParticleKernel kernel = ParticleKernel();
+    kernel.step       = &ParticleKernel::write;
+    kernel.positionsX = &m_positionsX[0];
+    kernel.positionsY = &m_positionsY[0];
+    kernel.ages       = &m_ages[0];
+    kernel.vertices   = &m_vertices[0];
+    kernel.colorRamp  = &m_colorRamp[0];
+    kernel.halfSize   = m_particleSize / 2.f;
+    runKernel(kernel, first, m_drawCount - first, m_threadCount);
+}
+
+
+////////////////////////////////////////////////////////////
+float ParticleSystem::random()
+{
+    // Xorshift generator: fast, and good enough for visual effects
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+
+    return static_cast<float>(m_random >> 8) / 16777216.f;
+}
+
+} // namespace sf
@@ -41,50 +41,72 @@ const RenderStates RenderStates::Default(BlendMode(
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates() :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (NULL)
+blendMode     (BlendAlpha),
+transform     (),
+texture       (NULL),
+shader        (NULL),
+scissor       (),
+scissorEnabled(false)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Transform& theTransform) :
-blendMode(BlendAlpha),
-transform(theTransform),
-texture  (NULL),
-shader   (NULL)
+blendMode     (BlendAlpha),
+transform     (theTransform),
+texture       (NULL),
+shader        (NULL),
+scissor       (),
+scissorEnabled(false)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode) :
-blendMode(theBlendMode),
-transform(),
-texture  (NULL),
-shader   (NULL)
+blendMode     (theBlendMode),
+transform     (),
+texture       (NULL),
+shader        (NULL),
+scissor       (),
+scissorEnabled(false)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Texture* theTexture) :
-blendMode(BlendAlpha),
-transform(),
-texture  (theTexture),
-shader   (NULL)
+blendMode     (BlendAlpha),
+transform     (),
+texture       (theTexture),
+shader        (NULL),
+scissor       (),
+scissorEnabled(false)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Shader* theShader) :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (theShader)
+blendMode     (BlendAlpha),
+transform     (),
+texture       (NULL),
+shader        (theShader),
+scissor       (),
+scissorEnabled(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderStates::RenderStates(const IntRect& theScissor) :
+blendMode     (BlendAlpha),
+transform     (),
+texture       (NULL),
+shader        (NULL),
+scissor       (theScissor),
+scissorEnabled(true)
 {
 }
 
@@ -92,10 +114,26 @@ shader   (theShader)
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode, const Transform& theTransform,
                            const Texture* theTexture, const Shader* theShader) :
-blendMode(theBlendMode),
-transform(theTransform),
-texture  (theTexture),
-shader   (theShader)
+blendMode     (theBlendMode),
+transform     (theTransform),
+texture       (theTexture),
+shader        (theShader),
+scissor       (),
+scissorEnabled(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderStates::RenderStates(const BlendMode& theBlendMode, const Transform& theTransform,
+                           const Texture* theTexture, const Shader* theShader,
+                           const IntRect& theScissor) :
+blendMode     (theBlendMode),
+transform     (theTransform),
+texture       (theTexture),
+shader        (theShader),
+scissor       (theScissor),
+scissorEnabled(true)
 {
 }
 
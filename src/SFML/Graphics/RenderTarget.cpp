@@ -30,6 +30,8 @@
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/CompactVertexArray.hpp>
+#include <SFML/Graphics/IndexArray.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/Err.hpp>
 #include <cassert>
@@ -82,7 +84,9 @@ namespace sf
 RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
-m_cache      ()
+m_cache      (),
+m_clipping   (false),
+m_clipArea   ()
 {
     m_cache.glStatesSet = false;
 }
@@ -97,11 +101,26 @@ RenderTarget::~RenderTarget()
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Nothing to clear if the clip area is empty
+    if (m_clipping && ((m_clipArea.width <= 0) || (m_clipArea.height <= 0)))
+        return;
+
     if (activate(true))
     {
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
+        // The scissor test also applies to glClear, but clear() must only be restricted by the clip area
+        if (m_clipping)
+        {
+            if (!m_cache.glStatesSet || !m_cache.lastScissorEnabled || (m_clipArea != m_cache.lastScissor))
+                applyScissor(true, m_clipArea);
+        }
+        else if (m_cache.glStatesSet && m_cache.lastScissorEnabled)
+        {
+            applyScissor(false, IntRect());
+        }
+
         glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
         glCheck(glClear(GL_COLOR_BUFFER_BIT));
     }
@@ -198,21 +217,124 @@ void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
 ////////////////////////////////////////////////////////////
 void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
                         PrimitiveType type, const RenderStates& states)
+{
+    drawPrimitives(vertices, vertexCount, false, type, states, NULL, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    drawPrimitives(vertices, vertexCount, false, type, states, indices, indexCount, sizeof(Uint16));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    drawPrimitives(vertices, vertexCount, false, type, states, indices, indexCount, sizeof(Uint32));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexArray& vertices, const IndexArray& indices, const RenderStates& states)
+{
+    if ((vertices.getVertexCount() == 0) || (indices.getIndexCount() == 0))
+        return;
+
+    if (indices.is32Bits())
+        draw(&vertices[0], vertices.getVertexCount(), &indices.m_indices32[0], indices.m_indices32.size(), vertices.getPrimitiveType(), states);
+    else
+        draw(&vertices[0], vertices.getVertexCount(), &indices.m_indices16[0], indices.m_indices16.size(), vertices.getPrimitiveType(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const CompactVertex* vertices, std::size_t vertexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    drawPrimitives(vertices, vertexCount, true, type, states, NULL, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const CompactVertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    drawPrimitives(vertices, vertexCount, true, type, states, indices, indexCount, sizeof(Uint16));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const CompactVertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    drawPrimitives(vertices, vertexCount, true, type, states, indices, indexCount, sizeof(Uint32));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const CompactVertexArray& vertices, const IndexArray& indices, const RenderStates& states)
+{
+    if ((vertices.getVertexCount() == 0) || (indices.getIndexCount() == 0))
+        return;
+
+    if (indices.is32Bits())
+        draw(&vertices[0], vertices.getVertexCount(), &indices.m_indices32[0], indices.m_indices32.size(), vertices.getPrimitiveType(), states);
+    else
+        draw(&vertices[0], vertices.getVertexCount(), &indices.m_indices16[0], indices.m_indices16.size(), vertices.getPrimitiveType(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawPrimitives(const void* vertices, std::size_t vertexCount, bool compact, PrimitiveType type, const RenderStates& states,
+                                  const void* indices, std::size_t indexCount, std::size_t indexSize)
 {
     // Nothing to draw?
-    if (!vertices || (vertexCount == 0))
+    if (!vertices || (vertexCount == 0) || (indices && (indexCount == 0)))
         return;
 
-    // GL_QUADS is unavailable on OpenGL ES
+    // GL_QUADS and 32-bit indices are unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (type == Quads)
         {
             err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
             return;
         }
+        if (indices && (indexSize == sizeof(Uint32)))
+        {
+            err() << "32-bit indices are not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
         #define GL_QUADS 0
+        #ifndef GL_UNSIGNED_INT
+            #define GL_UNSIGNED_INT 0
+        #endif
     #endif
 
+    // Combine the scissor rectangle with the clip area, if any
+    bool    scissorEnabled = states.scissorEnabled;
+    IntRect scissor        = states.scissor;
+    if (m_clipping)
+    {
+        if (scissorEnabled)
+        {
+            if (!scissor.intersects(m_clipArea, scissor))
+                return;
+        }
+        else
+        {
+            scissorEnabled = true;
+            scissor = m_clipArea;
+        }
+    }
+
+    // Nothing to draw if the enabled scissor rectangle is empty
+    if (scissorEnabled && ((scissor.width <= 0) || (scissor.height <= 0)))
+        return;
+
     if (activate(true))
     {
         // First set the persistent OpenGL states if it's the very first call
@@ -220,16 +342,18 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
             resetGLStates();
 
         // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
+        // (compact vertices can't hold transformed positions, they are never cached)
+        bool useVertexCache = !compact && (vertexCount <= StatesCache::VertexCacheSize);
         if (useVertexCache)
         {
             // Pre-transform the vertices and store them into the vertex cache
+            const Vertex* source = static_cast<const Vertex*>(vertices);
             for (std::size_t i = 0; i < vertexCount; ++i)
             {
                 Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
+                vertex.position = states.transform * source[i].position;
+                vertex.color = source[i].color;
+                vertex.texCoords = source[i].texCoords;
             }
 
             // Since vertices are transformed, we must use an identity transform to render them
@@ -241,6 +365,12 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
             applyTransform(states.transform);
         }
 
+        // Apply the scissor rectangle; its OpenGL origin is the bottom of the target,
+        // so it must also be refreshed when the view changes (e.g. after a resize)
+        if (m_cache.viewChanged || (scissorEnabled != m_cache.lastScissorEnabled) ||
+            (scissorEnabled && (scissor != m_cache.lastScissor)))
+            applyScissor(scissorEnabled, scissor);
+
         // Apply the view
         if (m_cache.viewChanged)
             applyCurrentView();
@@ -271,10 +401,19 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         // Setup the pointers to the vertices' components
         if (vertices)
         {
-            const char* data = reinterpret_cast<const char*>(vertices);
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            const char* data = static_cast<const char*>(vertices);
+            if (compact)
+            {
+                glCheck(glVertexPointer(2, GL_SHORT, sizeof(CompactVertex), data + 0));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(CompactVertex), data + 4));
+                glCheck(glTexCoordPointer(2, GL_SHORT, sizeof(CompactVertex), data + 8));
+            }
+            else
+            {
+                glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            }
         }
 
         // Find the OpenGL primitive type
@@ -283,7 +422,10 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         GLenum mode = modes[type];
 
         // Draw the primitives
-        glCheck(glDrawArrays(mode, 0, vertexCount));
+        if (indices)
+            glCheck(glDrawElements(mode, indexCount, (indexSize == sizeof(Uint16)) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, indices));
+        else
+            glCheck(glDrawArrays(mode, 0, vertexCount));
 
         // Unbind the shader, if any
         if (states.shader)
@@ -374,6 +516,7 @@ void RenderTarget::resetGLStates()
         glCheck(glDisable(GL_LIGHTING));
         glCheck(glDisable(GL_DEPTH_TEST));
         glCheck(glDisable(GL_ALPHA_TEST));
+        glCheck(glDisable(GL_SCISSOR_TEST));
         glCheck(glEnable(GL_TEXTURE_2D));
         glCheck(glEnable(GL_BLEND));
         glCheck(glMatrixMode(GL_MODELVIEW));
@@ -386,6 +529,8 @@ void RenderTarget::resetGLStates()
         applyBlendMode(BlendAlpha);
         applyTransform(Transform::Identity);
         applyTexture(NULL);
+        m_cache.lastScissorEnabled = false;
+        m_cache.lastScissor = IntRect();
         if (shaderAvailable)
             applyShader(NULL);
 
@@ -409,6 +554,22 @@ void RenderTarget::initialize()
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setClipArea(const IntRect& area)
+{
+    m_clipping = true;
+    m_clipArea = area;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetClipArea()
+{
+    m_clipping = false;
+    m_clipArea = IntRect();
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
@@ -485,6 +646,26 @@ void RenderTarget::applyTransform(const Transform& transform)
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::applyScissor(bool enabled, const IntRect& scissor)
+{
+    if (enabled)
+    {
+        // OpenGL window coordinates start at the bottom-left corner
+        int bottom = getSize().y - (scissor.top + scissor.height);
+        glCheck(glScissor(scissor.left, bottom, scissor.width, scissor.height));
+        glCheck(glEnable(GL_SCISSOR_TEST));
+    }
+    else
+    {
+        glCheck(glDisable(GL_SCISSOR_TEST));
+    }
+
+    m_cache.lastScissorEnabled = enabled;
+    m_cache.lastScissor = scissor;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTexture(const Texture* texture)
 {
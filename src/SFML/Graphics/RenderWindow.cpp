@@ -27,19 +27,59 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Number of previous frames whose damage is remembered; older back buffers are redrawn entirely
+    const std::size_t maxDamageHistory = 4;
+
+    // Check if a rectangle has no area
+    bool isEmpty(const sf::IntRect& rectangle)
+    {
+        return (rectangle.width <= 0) || (rectangle.height <= 0);
+    }
+
+    // Get the smallest rectangle containing two rectangles, ignoring empty ones
+    sf::IntRect merge(const sf::IntRect& first, const sf::IntRect& second)
+    {
+        if (isEmpty(first))
+            return second;
+        if (isEmpty(second))
+            return first;
+
+        int left   = std::min(first.left, second.left);
+        int top    = std::min(first.top, second.top);
+        int right  = std::max(first.left + first.width, second.left + second.width);
+        int bottom = std::max(first.top + first.height, second.top + second.height);
+
+        return sf::IntRect(left, top, right - left, bottom - top);
+    }
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow()
+RenderWindow::RenderWindow() :
+m_damageTracking(false),
+m_fullRedraw    (true),
+m_bufferAge     (0),
+m_damage        (),
+m_damageHistory ()
 {
     // Nothing to do
 }
 
 
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings)
+RenderWindow::RenderWindow(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
+m_damageTracking(false),
+m_fullRedraw    (true),
+m_bufferAge     (0),
+m_damage        (),
+m_damageHistory ()
 {
     // Don't call the base class constructor because it contains virtual function calls
     create(mode, title, style, settings);
@@ -47,7 +87,12 @@ RenderWindow::RenderWindow(VideoMode mode, const String& title, Uint32 style, co
 
 
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow(WindowHandle handle, const ContextSettings& settings)
+RenderWindow::RenderWindow(WindowHandle handle, const ContextSettings& settings) :
+m_damageTracking(false),
+m_fullRedraw    (true),
+m_bufferAge     (0),
+m_damage        (),
+m_damageHistory ()
 {
     // Don't call the base class constructor because it contains virtual function calls
     create(handle, settings);
@@ -99,11 +144,100 @@ Image RenderWindow::capture() const
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderWindow::setDamageTrackingEnabled(bool enabled)
+{
+    m_damageTracking = enabled;
+    invalidateDamage();
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderWindow::isDamageTrackingEnabled() const
+{
+    return m_damageTracking;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::addDirtyRegion(const IntRect& region)
+{
+    if (!m_damageTracking)
+        return;
+
+    // Ignore the parts of the region which are outside the window
+    IntRect visible;
+    if (!region.intersects(IntRect(0, 0, static_cast<int>(getSize().x), static_cast<int>(getSize().y)), visible))
+        return;
+
+    m_damage = merge(m_damage, visible);
+    updateClipArea();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::addDirtyRegion(const FloatRect& area)
+{
+    if (!m_damageTracking)
+        return;
+
+    // Map the 4 corners, since the view may be rotated
+    Vector2i corners[4] =
+    {
+        mapCoordsToPixel(Vector2f(area.left, area.top)),
+        mapCoordsToPixel(Vector2f(area.left + area.width, area.top)),
+        mapCoordsToPixel(Vector2f(area.left, area.top + area.height)),
+        mapCoordsToPixel(Vector2f(area.left + area.width, area.top + area.height))
+    };
+
+    Vector2i min = corners[0];
+    Vector2i max = corners[0];
+    for (int i = 1; i < 4; ++i)
+    {
+        min.x = std::min(min.x, corners[i].x);
+        min.y = std::min(min.y, corners[i].y);
+        max.x = std::max(max.x, corners[i].x);
+        max.y = std::max(max.y, corners[i].y);
+    }
+
+    // Pixel coordinates are truncated, and smooth textures and antialiasing
+    // may leak outside the exact bounds: add a margin of one pixel
+    addDirtyRegion(IntRect(min.x - 1, min.y - 1, max.x - min.x + 3, max.y - min.y + 3));
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect RenderWindow::getRedrawRegion() const
+{
+    IntRect window(0, 0, static_cast<int>(getSize().x), static_cast<int>(getSize().y));
+
+    if (!m_damageTracking || m_fullRedraw)
+        return window;
+
+    // Nothing changed: the front buffer is still up to date
+    if (isEmpty(m_damage))
+        return IntRect();
+
+    // The back buffer also misses what changed in the frames displayed since it was rendered;
+    // if its contents are unknown or too old, everything must be redrawn
+    if ((m_bufferAge == 0) || (m_bufferAge - 1 > m_damageHistory.size()))
+        return window;
+
+    IntRect region = m_damage;
+    for (std::size_t i = 0; i < m_bufferAge - 1; ++i)
+        region = merge(region, m_damageHistory[i]);
+
+    return region;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderWindow::onCreate()
 {
     // Just initialize the render target part
     RenderTarget::initialize();
+
+    invalidateDamage();
 }
 
 
@@ -112,6 +246,73 @@ void RenderWindow::onResize()
 {
     // Update the current view (recompute the viewport, which is stored in relative coordinates)
     setView(getView());
+
+    // The contents of the back buffers are lost
+    invalidateDamage();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    if (!m_damageTracking)
+    {
+        Window::onDisplay();
+        return;
+    }
+
+    IntRect window(0, 0, static_cast<int>(getSize().x), static_cast<int>(getSize().y));
+
+    if (m_fullRedraw)
+    {
+        Window::onDisplay();
+        m_damage = window;
+    }
+    else if (!isEmpty(m_damage))
+    {
+        // Tell the system which part of the frame changed since the previous one
+        // (OpenGL window coordinates start at the bottom-left corner)
+        int rectangle[4] = {m_damage.left, window.height - (m_damage.top + m_damage.height), m_damage.width, m_damage.height};
+        Window::displayDamage(rectangle, 1);
+    }
+
+    // If nothing changed, the buffers are not swapped at all
+
+    // Remember what changed in the frame that was presented
+    if (!isEmpty(m_damage))
+    {
+        m_damageHistory.insert(m_damageHistory.begin(), m_damage);
+        if (m_damageHistory.size() > maxDamageHistory)
+            m_damageHistory.pop_back();
+
+        m_bufferAge = getBufferAge();
+    }
+
+    // Start a new frame
+    m_damage = IntRect();
+    m_fullRedraw = false;
+    updateClipArea();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::updateClipArea()
+{
+    if (m_damageTracking)
+        setClipArea(getRedrawRegion());
+    else
+        resetClipArea();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::invalidateDamage()
+{
+    m_fullRedraw = true;
+    m_bufferAge = 0;
+    m_damage = IntRect();
+    m_damageHistory.clear();
+    updateClipArea();
 }
 
 } // namespace sf
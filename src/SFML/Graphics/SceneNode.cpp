@@ -0,0 +1,337 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SceneNode.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // A rectangle is empty when it doesn't cover anything, not even a point
+    bool isEmpty(const sf::FloatRect& rect)
+    {
+        return (rect.width == 0.f) && (rect.height == 0.f);
+    }
+
+    // Compute the smallest rectangle containing two (non-empty) rectangles
+    sf::FloatRect merge(const sf::FloatRect& a, const sf::FloatRect& b)
+    {
+        float left   = std::min(a.left, b.left);
+        float top    = std::min(a.top, b.top);
+        float right  = std::max(a.left + a.width, b.left + b.width);
+        float bottom = std::max(a.top + a.height, b.top + b.height);
+
+        return sf::FloatRect(left, top, right - left, bottom - top);
+    }
+
+    // Check whether a (non-empty) rectangle touches an area; unlike
+    // Rect::intersects, rectangles of zero width or height are allowed
+    bool overlaps(const sf::FloatRect& rect, const sf::FloatRect& area)
+    {
+        return !isEmpty(rect) &&
+               (rect.left <= area.left + area.width) && (area.left <= rect.left + rect.width) &&
+               (rect.top <= area.top + area.height) && (area.top <= rect.top + rect.height);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SceneNode::SceneNode() :
+m_parent                  (NULL),
+m_children                (),
+m_content                 (NULL),
+m_contentBounds           (),
+m_worldTransform          (),
+m_worldTransformNeedUpdate(true),
+m_contentWorldBounds      (),
+m_worldBounds             (),
+m_worldBoundsNeedUpdate   (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode::~SceneNode()
+{
+    if (m_parent)
+        m_parent->detachChild(*this);
+
+    for (std::vector<SceneNode*>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+    {
+        (*it)->m_parent = NULL;
+        (*it)->invalidateWorldTransforms();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::attachChild(SceneNode& child)
+{
+    if (child.m_parent == this)
+        return;
+
+    // Make sure that we don't create a cycle
+    for (const SceneNode* node = this; node; node = node->m_parent)
+    {
+        if (node == &child)
+        {
+            err() << "Failed to attach scene node (a node cannot be attached to itself or to one of its descendants)" << std::endl;
+            return;
+        }
+    }
+
+    if (child.m_parent)
+        child.m_parent->detachChild(child);
+
+    m_children.push_back(&child);
+    child.m_parent = this;
+
+    // The whole subtree of the child is now relative to this node
+    child.invalidateWorldTransforms();
+    invalidateWorldBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::detachChild(SceneNode& child)
+{
+    std::vector<SceneNode*>::iterator it = std::find(m_children.begin(), m_children.end(), &child);
+    if (it == m_children.end())
+        return;
+
+    m_children.erase(it);
+    child.m_parent = NULL;
+
+    child.invalidateWorldTransforms();
+    invalidateWorldBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode* SceneNode::getParent() const
+{
+    return m_parent;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneNode::getChildCount() const
+{
+    return m_children.size();
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode& SceneNode::getChild(std::size_t index) const
+{
+    return *m_children[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::setContent(const Drawable* content, const FloatRect& bounds)
+{
+    m_content = content;
+    m_contentBounds = bounds;
+    invalidateWorldBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+const Drawable* SceneNode::getContent() const
+{
+    return m_content;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::invalidateBounds()
+{
+    invalidateWorldBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+const Transform& SceneNode::getWorldTransform() const
+{
+    if (m_worldTransformNeedUpdate)
+    {
+        if (m_parent)
+            m_worldTransform = m_parent->getWorldTransform() * getTransform();
+        else
+            m_worldTransform = getTransform();
+
+        m_worldTransformNeedUpdate = false;
+    }
+
+    return m_worldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+const FloatRect& SceneNode::getWorldBounds() const
+{
+    ensureBoundsUpdate();
+
+    return m_worldBounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::findVisibleNodes(const FloatRect& area, std::vector<const SceneNode*>& nodes) const
+{
+    ensureBoundsUpdate();
+
+    if (!overlaps(m_worldBounds, area))
+        return;
+
+    if (overlaps(m_contentWorldBounds, area))
+        nodes.push_back(this);
+
+    for (std::vector<SceneNode*>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+        (*it)->findVisibleNodes(area, nodes);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::drawContent(RenderTarget& target, RenderStates states) const
+{
+    if (m_content)
+        target.draw(*m_content, states);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect SceneNode::getContentBounds() const
+{
+    return m_contentBounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::draw(RenderTarget& target, RenderStates states) const
+{
+    // The world transform of the node already includes its ancestors,
+    // so the given states are those of the root of the hierarchy
+    const View& view = target.getView();
+    FloatRect viewArea = view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    FloatRect area = states.transform.getInverse().transformRect(viewArea);
+
+    drawSubtree(target, states, area);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::drawSubtree(RenderTarget& target, const RenderStates& states, const FloatRect& area) const
+{
+    ensureBoundsUpdate();
+
+    // Skip the whole subtree if it is outside the view
+    if (!overlaps(m_worldBounds, area))
+        return;
+
+    if (overlaps(m_contentWorldBounds, area))
+    {
+        RenderStates contentStates(states);
+        contentStates.transform *= getWorldTransform();
+        drawContent(target, contentStates);
+    }
+
+    for (std::vector<SceneNode*>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+        (*it)->drawSubtree(target, states, area);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::onTransformChange()
+{
+    invalidateWorldTransforms();
+    if (m_parent)
+        m_parent->invalidateWorldBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::invalidateWorldTransforms()
+{
+    // If the world transform of a node is outdated, so are the world
+    // transforms and bounds of all its descendants: a node can only be
+    // updated after its parent
+    if (m_worldTransformNeedUpdate)
+        return;
+
+    m_worldTransformNeedUpdate = true;
+    m_worldBoundsNeedUpdate = true;
+
+    for (std::vector<SceneNode*>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+        (*it)->invalidateWorldTransforms();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::invalidateWorldBounds()
+{
+    // If the bounds of a node are outdated, so are the bounds of all
+    // its ancestors: a node can only be updated after its children
+    for (SceneNode* node = this; node && !node->m_worldBoundsNeedUpdate; node = node->m_parent)
+        node->m_worldBoundsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::ensureBoundsUpdate() const
+{
+    if (!m_worldBoundsNeedUpdate)
+        return;
+
+    // Bounds of the content of the node
+    FloatRect contentBounds = getContentBounds();
+    if (isEmpty(contentBounds))
+        m_contentWorldBounds = FloatRect();
+    else
+        m_contentWorldBounds = getWorldTransform().transformRect(contentBounds);
+
+    // Merge with the bounds of the children
+    m_worldBounds = m_contentWorldBounds;
+    for (std::vector<SceneNode*>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+    {
+        const FloatRect& childBounds = (*it)->getWorldBounds();
+        if (isEmpty(childBounds))
+            continue;
+
+        m_worldBounds = isEmpty(m_worldBounds) ? childBounds : merge(m_worldBounds, childBounds);
+    }
+
+    m_worldBoundsNeedUpdate = false;
+}
+
+} // namespace sf
@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ShapeBatch.hpp>
+#include <SFML/Graphics/Shape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ShapeBatch::ShapeBatch() :
+m_items             (),
+m_texture           (NULL),
+m_vertices          (Triangles),
+m_indices           (),
+m_geometryNeedUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ShapeBatch::add(const Shape& shape)
+{
+    // The new shape goes after the geometry that is already built
+    Item item(&shape);
+    item.firstVertex = m_vertices.getVertexCount();
+    item.firstIndex  = m_indices.getIndexCount();
+
+    m_items.push_back(item);
+    m_geometryNeedUpdate = true;
+
+    return m_items.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ShapeBatch::getShapeCount() const
+{
+    return m_items.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::clear()
+{
+    m_items.clear();
+    m_vertices.clear();
+    m_indices.clear();
+    m_geometryNeedUpdate = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::invalidate(std::size_t index)
+{
+    m_items[index].needUpdate = true;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::invalidate()
+{
+    for (std::vector<Item>::iterator it = m_items.begin(); it != m_items.end(); ++it)
+        it->needUpdate = true;
+    m_geometryNeedUpdate = !m_items.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::setTexture(const Texture* texture)
+{
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* ShapeBatch::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect ShapeBatch::getBounds() const
+{
+    ensureGeometryUpdate();
+
+    return m_vertices.getBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    ensureGeometryUpdate();
+
+    states.texture = m_texture;
+    target.draw(m_vertices, m_indices, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::ensureGeometryUpdate() const
+{
+    if (!m_geometryNeedUpdate)
+        return;
+
+    m_geometryNeedUpdate = false;
+
+    // Shapes whose number of fill and outline vertices didn't change are updated in place
+    // (their triangles stay the same); from the first one that changed, the positions in
+    // the arrays shift and everything is rebuilt
+    std::size_t rebuildFrom = m_items.size();
+    for (std::size_t i = 0; i < m_items.size(); ++i)
+    {
+        Item& item = m_items[i];
+        if (!item.needUpdate)
+            continue;
+
+        const Shape& shape = *item.shape;
+        std::size_t fillCount    = shape.m_vertices.getVertexCount();
+        std::size_t outlineCount = (shape.m_outlineThickness != 0) ? shape.m_outlineVertices.getVertexCount() : 0;
+
+        if ((fillCount != item.fillCount) || (outlineCount != item.outlineCount))
+        {
+            rebuildFrom = i;
+            break;
+        }
+
+        writeShape(shape, item.firstVertex, false);
+        item.needUpdate = false;
+    }
+
+    if (rebuildFrom < m_items.size())
+    {
+        m_vertices.resize(m_items[rebuildFrom].firstVertex);
+        m_indices.resize(m_items[rebuildFrom].firstIndex);
+
+        for (std::size_t i = rebuildFrom; i < m_items.size(); ++i)
+        {
+            Item& item = m_items[i];
+            item.firstVertex = m_vertices.getVertexCount();
+            item.firstIndex  = m_indices.getIndexCount();
+            writeShape(*item.shape, item.firstVertex, true);
+            item.fillCount    = item.shape->m_vertices.getVertexCount();
+            item.outlineCount = m_vertices.getVertexCount() - item.firstVertex - item.fillCount;
+            item.needUpdate   = false;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ShapeBatch::writeShape(const Shape& shape, std::size_t firstVertex, bool addIndices) const
+{
+    const Transform&   transform = shape.getTransform();
+    const VertexArray& fill      = shape.m_vertices;
+    const VertexArray& outline   = shape.m_outlineVertices;
+
+    std::size_t fillCount    = fill.getVertexCount();
+    std::size_t outlineCount = (shape.m_outlineThickness != 0) ? outline.getVertexCount() : 0;
+    if (m_vertices.getVertexCount() < firstVertex + fillCount + outlineCount)
+        m_vertices.resize(firstVertex + fillCount + outlineCount);
+
+    // The fill is a triangle fan around its first vertex
+    for (std::size_t i = 0; i < fillCount; ++i)
+    {
+        Vertex& vertex = m_vertices[firstVertex + i];
+        vertex = fill[i];
+        vertex.position = transform.transformPoint(vertex.position);
+    }
+    if (addIndices)
+    {
+        Uint32 center = static_cast<Uint32>(firstVertex);
+        for (std::size_t i = 1; i + 1 < fillCount; ++i)
+        {
+            m_indices.append(center);
+            m_indices.append(center + static_cast<Uint32>(i));
+            m_indices.append(center + static_cast<Uint32>(i + 1));
+        }
+    }
+
+    // The outline is a triangle strip, drawn over the fill
+    std::size_t firstOutlineVertex = firstVertex + fillCount;
+    for (std::size_t i = 0; i < outlineCount; ++i)
+    {
+        Vertex& vertex = m_vertices[firstOutlineVertex + i];
+        vertex = outline[i];
+        vertex.position = transform.transformPoint(vertex.position);
+    }
+    if (addIndices)
+    {
+        Uint32 first = static_cast<Uint32>(firstOutlineVertex);
+        for (std::size_t i = 0; i + 2 < outlineCount; ++i)
+        {
+            m_indices.append(first + static_cast<Uint32>(i));
+            m_indices.append(first + static_cast<Uint32>(i + 1));
+            m_indices.append(first + static_cast<Uint32>(i + 2));
+        }
+    }
+}
+
+} // namespace sf
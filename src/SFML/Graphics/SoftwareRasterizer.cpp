@@ -0,0 +1,539 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SoftwareRasterizer.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Size of a tile, in pixels
+    const int tileSize = 64;
+
+    // Number of bits of the fractional part of the vertex positions,
+    // as used by most graphics hardware
+    const int subPixelBits = 8;
+    const sf::Int64 subPixelScale = 1 << subPixelBits;
+
+    // Vertices farther than this (in 1/256th of pixel) are clamped,
+    // so that the edge functions can't overflow
+    const double maxCoordinate = 1 << 29;
+
+    // Minimum number of triangles worth using several threads
+    const std::size_t trianglesPerThread = 64;
+
+    // Convert a position to fixed point
+    sf::Int64 toFixed(float coordinate)
+    {
+        double value = std::floor(coordinate * static_cast<double>(subPixelScale) + 0.5);
+        if (!(value > -maxCoordinate))
+            return static_cast<sf::Int64>(-maxCoordinate);
+        if (!(value < maxCoordinate))
+            return static_cast<sf::Int64>(maxCoordinate);
+
+        return static_cast<sf::Int64>(value);
+    }
+
+    // Divide a fixed point coordinate by the size of a pixel, rounding down
+    int floorToPixel(sf::Int64 coordinate)
+    {
+        return static_cast<int>(coordinate >= 0 ? coordinate / subPixelScale : -((-coordinate + subPixelScale - 1) / subPixelScale));
+    }
+
+    // Compute the intersection of two rectangles, possibly empty
+    sf::IntRect intersect(const sf::IntRect& a, const sf::IntRect& b)
+    {
+        int left   = std::max(a.left, b.left);
+        int top    = std::max(a.top, b.top);
+        int right  = std::min(a.left + a.width, b.left + b.width);
+        int bottom = std::min(a.top + a.height, b.top + b.height);
+
+        return sf::IntRect(left, top, std::max(right - left, 0), std::max(bottom - top, 0));
+    }
+
+    // Fetch a texel, either repeating or clamping the coordinates
+    const sf::Uint8* getTexel(const sf::priv::SoftwareRasterizer::TextureData& texture, int x, int y)
+    {
+        int width  = static_cast<int>(texture.width);
+        int height = static_cast<int>(texture.height);
+        if (texture.repeated)
+        {
+            x %= width;
+            y %= height;
+            if (x < 0) x += width;
+            if (y < 0) y += height;
+        }
+        else
+        {
+            x = std::min(std::max(x, 0), width - 1);
+            y = std::min(std::max(y, 0), height - 1);
+        }
+
+        return &texture.pixels[(static_cast<std::size_t>(y) * width + x) * 4];
+    }
+
+    // Sample a texture at the given coordinates (in pixels), the result is in [0, 1]
+    void sample(const sf::priv::SoftwareRasterizer::TextureData& texture, float u, float v, float* result)
+    {
+        if (!texture.smooth)
+        {
+            const sf::Uint8* texel = getTexel(texture, static_cast<int>(std::floor(u)), static_cast<int>(std::floor(v)));
+            for (int i = 0; i < 4; ++i)
+                result[i] = texel[i] / 255.f;
+            return;
+        }
+
+        // Bilinear filtering between the 4 texels around the sample
+        float x = u - 0.5f;
+        float y = v - 0.5f;
+        float left = std::floor(x);
+        float top  = std::floor(y);
+        float fx = x - left;
+        float fy = y - top;
+        int ix = static_cast<int>(left);
+        int iy = static_cast<int>(top);
+
+        const sf::Uint8* t00 = getTexel(texture, ix,     iy);
+        const sf::Uint8* t10 = getTexel(texture, ix + 1, iy);
+        const sf::Uint8* t01 = getTexel(texture, ix,     iy + 1);
+        const sf::Uint8* t11 = getTexel(texture, ix + 1, iy + 1);
+        for (int i = 0; i < 4; ++i)
+        {
+            float top    = t00[i] + (t10[i] - t00[i]) * fx;
+            float bottom = t01[i] + (t11[i] - t01[i]) * fx;
+            result[i] = (top + (bottom - top) * fy) / 255.f;
+        }
+    }
+
+    // Compute a blending factor for one component
+    float getFactor(sf::BlendMode::Factor factor, float source, float sourceAlpha, float destination, float destinationAlpha)
+    {
+        switch (factor)
+        {
+            default:
+            case sf::BlendMode::Zero:             return 0.f;
+            case sf::BlendMode::One:              return 1.f;
+            case sf::BlendMode::SrcColor:         return source;
+            case sf::BlendMode::OneMinusSrcColor: return 1.f - source;
+            case sf::BlendMode::DstColor:         return destination;
+            case sf::BlendMode::OneMinusDstColor: return 1.f - destination;
+            case sf::BlendMode::SrcAlpha:         return sourceAlpha;
+            case sf::BlendMode::OneMinusSrcAlpha: return 1.f - sourceAlpha;
+            case sf::BlendMode::DstAlpha:         return destinationAlpha;
+            case sf::BlendMode::OneMinusDstAlpha: return 1.f - destinationAlpha;
+        }
+    }
+
+    // Combine a source component with a destination component, and convert the result to 8 bits
+    sf::Uint8 blend(sf::BlendMode::Factor sourceFactor, sf::BlendMode::Factor destinationFactor, sf::BlendMode::Equation equation,
+                    float source, float sourceAlpha, float destination, float destinationAlpha)
+    {
+        float s = source * getFactor(sourceFactor, source, sourceAlpha, destination, destinationAlpha);
+        float d = destination * getFactor(destinationFactor, source, sourceAlpha, destination, destinationAlpha);
+        float result = (equation == sf::BlendMode::Add) ? s + d : s - d;
+
+        return static_cast<sf::Uint8>(std::min(std::max(result, 0.f), 1.f) * 255.f + 0.5f);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+struct SoftwareRasterizer::TileWorker
+{
+    void run()
+    {
+        rasterizer->rasterizeTiles(first, step);
+    }
+
+    SoftwareRasterizer* rasterizer;
+    std::size_t         first;
+    std::size_t         step;
+};
+
+
+////////////////////////////////////////////////////////////
+SoftwareRasterizer::SoftwareRasterizer() :
+m_width      (0),
+m_height     (0),
+m_pixels     (),
+m_vertices   (),
+m_batches    (),
+m_triangles  (),
+m_tiles      (),
+m_tilesPerRow(0),
+m_textures   (),
+m_outdated   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+    for (TextureTable::iterator it = m_textures.begin(); it != m_textures.end(); ++it)
+        delete it->second.second;
+    for (std::vector<TextureData*>::iterator it = m_outdated.begin(); it != m_outdated.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::resize(unsigned int width, unsigned int height)
+{
+    m_width  = width;
+    m_height = height;
+    m_pixels.assign(static_cast<std::size_t>(width) * height * 4, 0);
+
+    m_tilesPerRow = (width + tileSize - 1) / tileSize;
+    unsigned int tilesPerColumn = (height + tileSize - 1) / tileSize;
+    m_tiles.clear();
+    m_tiles.resize(m_tilesPerRow * tilesPerColumn);
+
+    m_vertices.clear();
+    m_batches.clear();
+    m_triangles.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::clear(const Color& color)
+{
+    m_vertices.clear();
+    m_batches.clear();
+    m_triangles.clear();
+
+    for (std::size_t i = 0; i < m_pixels.size(); i += 4)
+    {
+        m_pixels[i + 0] = color.r;
+        m_pixels[i + 1] = color.g;
+        m_pixels[i + 2] = color.b;
+        m_pixels[i + 3] = color.a;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const SoftwareRasterizer::TextureData* SoftwareRasterizer::getTextureData(const Texture& texture, Uint64 version)
+{
+    TextureTable::iterator it = m_textures.find(&texture);
+    if ((it != m_textures.end()) && (it->second.first == version) &&
+        (it->second.second->smooth == texture.isSmooth()) && (it->second.second->repeated == texture.isRepeated()))
+        return it->second.second;
+
+    // Download the pixels of the texture
+    Image image = texture.copyToImage();
+    TextureData* data = new TextureData;
+    data->width    = image.getSize().x;
+    data->height   = image.getSize().y;
+    data->smooth   = texture.isSmooth();
+    data->repeated = texture.isRepeated();
+    if (data->width && data->height)
+        data->pixels.assign(image.getPixelsPtr(), image.getPixelsPtr() + data->width * data->height * 4);
+    else
+        data->pixels.assign(4, 255);
+    data->width  = std::max(data->width, 1u);
+    data->height = std::max(data->height, 1u);
+
+    // The previous copy may still be used by pending triangles
+    if (it != m_textures.end())
+    {
+        m_outdated.push_back(it->second.second);
+        it->second = std::make_pair(version, data);
+    }
+    else
+    {
+        m_textures.insert(std::make_pair(&texture, std::make_pair(version, data)));
+    }
+
+    return data;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::beginBatch(const BlendMode& blendMode, const TextureData* texture, const IntRect& clip)
+{
+    Batch batch;
+    batch.blendMode = blendMode;
+    batch.texture   = texture;
+    batch.clip      = intersect(clip, IntRect(0, 0, m_width, m_height));
+    m_batches.push_back(batch);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 SoftwareRasterizer::addVertex(const Vector2f& position, const Color& color, const Vector2f& texCoords)
+{
+    RasterVertex vertex;
+    vertex.x = toFixed(position.x);
+    vertex.y = toFixed(position.y);
+    vertex.r = color.r / 255.f;
+    vertex.g = color.g / 255.f;
+    vertex.b = color.b / 255.f;
+    vertex.a = color.a / 255.f;
+    vertex.u = texCoords.x;
+    vertex.v = texCoords.y;
+    m_vertices.push_back(vertex);
+
+    return static_cast<Uint32>(m_vertices.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::addTriangle(Uint32 a, Uint32 b, Uint32 c)
+{
+    if (m_batches.empty())
+        return;
+
+    const RasterVertex& v0 = m_vertices[a];
+    const RasterVertex& v1 = m_vertices[b];
+    const RasterVertex& v2 = m_vertices[c];
+
+    // Skip degenerate triangles, and orient the others consistently
+    Int64 area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (area == 0)
+        return;
+
+    Triangle triangle;
+    triangle.vertices[0] = a;
+    triangle.vertices[1] = area > 0 ? b : c;
+    triangle.vertices[2] = area > 0 ? c : b;
+    triangle.batch = static_cast<Uint32>(m_batches.size() - 1);
+
+    // Compute the pixels that the triangle may cover, and skip it if there's none
+    int left   = floorToPixel(std::min(v0.x, std::min(v1.x, v2.x)));
+    int top    = floorToPixel(std::min(v0.y, std::min(v1.y, v2.y)));
+    int right  = floorToPixel(std::max(v0.x, std::max(v1.x, v2.x))) + 1;
+    int bottom = floorToPixel(std::max(v0.y, std::max(v1.y, v2.y))) + 1;
+    triangle.bounds = intersect(IntRect(left, top, right - left, bottom - top), m_batches.back().clip);
+    if ((triangle.bounds.width == 0) || (triangle.bounds.height == 0))
+        return;
+
+    m_triangles.push_back(triangle);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::flush(unsigned int threadCount)
+{
+    if (!m_triangles.empty())
+    {
+        // Distribute the triangles into the tiles they overlap
+        for (std::size_t i = 0; i < m_triangles.size(); ++i)
+        {
+            const IntRect& bounds = m_triangles[i].bounds;
+            int firstColumn = bounds.left / tileSize;
+            int lastColumn  = (bounds.left + bounds.width - 1) / tileSize;
+            int firstRow    = bounds.top / tileSize;
+            int lastRow     = (bounds.top + bounds.height - 1) / tileSize;
+
+            for (int row = firstRow; row <= lastRow; ++row)
+                for (int column = firstColumn; column <= lastColumn; ++column)
+                    m_tiles[row * m_tilesPerRow + column].push_back(static_cast<Uint32>(i));
+        }
+
+        // Rasterize the tiles, interleaved between the threads so that
+        // they share the busy areas of the image
+        std::size_t count = std::min<std::size_t>(std::max(threadCount, 1u), m_tiles.size());
+        count = std::max<std::size_t>(std::min(count, m_triangles.size() / trianglesPerThread), 1);
+
+        std::vector<TileWorker> workers(count);
+        std::vector<Thread*> threads(count, NULL);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            workers[i].rasterizer = this;
+            workers[i].first      = i;
+            workers[i].step       = count;
+            if (i > 0)
+            {
+                threads[i] = new Thread(&TileWorker::run, &workers[i]);
+                threads[i]->launch();
+            }
+        }
+
+        workers[0].run();
+
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            threads[i]->wait();
+            delete threads[i];
+        }
+    }
+
+    m_vertices.clear();
+    m_batches.clear();
+    m_triangles.clear();
+
+    // No pending triangle can use the outdated texture copies anymore
+    for (std::vector<TextureData*>::iterator it = m_outdated.begin(); it != m_outdated.end(); ++it)
+        delete *it;
+    m_outdated.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* SoftwareRasterizer::getPixels() const
+{
+    return m_pixels.empty() ? NULL : &m_pixels[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::rasterizeTiles(std::size_t first, std::size_t step)
+{
+    for (std::size_t i = first; i < m_tiles.size(); i += step)
+    {
+        std::vector<Uint32>& triangles = m_tiles[i];
+        if (triangles.empty())
+            continue;
+
+        IntRect tile(static_cast<int>(i % m_tilesPerRow) * tileSize, static_cast<int>(i / m_tilesPerRow) * tileSize, tileSize, tileSize);
+        for (std::vector<Uint32>::const_iterator it = triangles.begin(); it != triangles.end(); ++it)
+        {
+            const Triangle& triangle = m_triangles[*it];
+            rasterizeTriangle(triangle, intersect(tile, triangle.bounds));
+        }
+
+        triangles.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRasterizer::rasterizeTriangle(const Triangle& triangle, const IntRect& area)
+{
+    if ((area.width <= 0) || (area.height <= 0))
+        return;
+
+    const RasterVertex* v[3] = {&m_vertices[triangle.vertices[0]], &m_vertices[triangle.vertices[1]], &m_vertices[triangle.vertices[2]]};
+    const Batch& batch = m_batches[triangle.batch];
+
+    // Setup the edge functions; edge i is opposite to vertex i, so that its
+    // value is proportional to the barycentric coordinate of vertex i.
+    // Pixels exactly on an edge belong to the triangle only if the edge
+    // is a top or left edge, so that adjacent triangles never overlap
+    Int64 startX = area.left * subPixelScale + subPixelScale / 2;
+    Int64 startY = area.top * subPixelScale + subPixelScale / 2;
+    Int64 row[3];
+    Int64 stepX[3];
+    Int64 stepY[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        const RasterVertex& a = *v[(i + 1) % 3];
+        const RasterVertex& b = *v[(i + 2) % 3];
+        Int64 dx = b.x - a.x;
+        Int64 dy = b.y - a.y;
+        bool topLeft = (dy < 0) || ((dy == 0) && (dx > 0));
+
+        row[i]   = dx * (startY - a.y) - dy * (startX - a.x) - (topLeft ? 0 : 1);
+        stepX[i] = -dy * subPixelScale;
+        stepY[i] = dx * subPixelScale;
+    }
+
+    // The edge functions sum up to twice the area of the triangle
+    const RasterVertex& a = *v[0];
+    const RasterVertex& b = *v[1];
+    const RasterVertex& c = *v[2];
+    float invArea = static_cast<float>(1.0 / static_cast<double>((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)));
+
+    const BlendMode& mode = batch.blendMode;
+    bool alphaBlending = (mode == BlendAlpha);
+    const TextureData* texture = batch.texture;
+
+    for (int y = area.top; y < area.top + area.height; ++y)
+    {
+        Int64 e0 = row[0];
+        Int64 e1 = row[1];
+        Int64 e2 = row[2];
+        Uint8* pixel = &m_pixels[(static_cast<std::size_t>(y) * m_width + area.left) * 4];
+
+        for (int x = area.left; x < area.left + area.width; ++x, pixel += 4)
+        {
+            if ((e0 | e1 | e2) >= 0)
+            {
+                // Interpolate the attributes of the vertices
+                float w0 = static_cast<float>(e0) * invArea;
+                float w1 = static_cast<float>(e1) * invArea;
+                float w2 = 1.f - w0 - w1;
+
+                float source[4] = {w0 * v[0]->r + w1 * v[1]->r + w2 * v[2]->r,
+                                   w0 * v[0]->g + w1 * v[1]->g + w2 * v[2]->g,
+                                   w0 * v[0]->b + w1 * v[1]->b + w2 * v[2]->b,
+                                   w0 * v[0]->a + w1 * v[1]->a + w2 * v[2]->a};
+
+                // Modulate the color with the texture
+                if (texture)
+                {
+                    float texel[4];
+                    sample(*texture,
+                           w0 * v[0]->u + w1 * v[1]->u + w2 * v[2]->u,
+                           w0 * v[0]->v + w1 * v[1]->v + w2 * v[2]->v,
+                           texel);
+                    for (int i = 0; i < 4; ++i)
+                        source[i] *= texel[i];
+                }
+
+                // Blend with the destination
+                if (alphaBlending)
+                {
+                    // Fast path for the default blend mode
+                    float inverseAlpha = 1.f - source[3];
+                    for (int i = 0; i < 3; ++i)
+                        pixel[i] = static_cast<Uint8>((source[i] * source[3] * 255.f) + pixel[i] * inverseAlpha + 0.5f);
+                    pixel[3] = static_cast<Uint8>((source[3] * 255.f) + pixel[3] * inverseAlpha + 0.5f);
+                }
+                else
+                {
+                    float destination[4] = {pixel[0] / 255.f, pixel[1] / 255.f, pixel[2] / 255.f, pixel[3] / 255.f};
+                    for (int i = 0; i < 3; ++i)
+                        pixel[i] = blend(mode.colorSrcFactor, mode.colorDstFactor, mode.colorEquation, source[i], source[3], destination[i], destination[3]);
+                    pixel[3] = blend(mode.alphaSrcFactor, mode.alphaDstFactor, mode.alphaEquation, source[3], source[3], destination[3], destination[3]);
+                }
+            }
+
+            e0 += stepX[0];
+            e1 += stepX[1];
+            e2 += stepX[2];
+        }
+
+        row[0] += stepY[0];
+        row[1] += stepY[1];
+        row[2] += stepY[2];
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
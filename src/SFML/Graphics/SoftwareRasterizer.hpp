@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOFTWARERASTERIZER_HPP
+#define SFML_SOFTWARERASTERIZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Tiled triangle rasterizer working in system memory
+///
+////////////////////////////////////////////////////////////
+class SoftwareRasterizer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy of the pixels of a texture, for sampling
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TextureData
+    {
+        std::vector<Uint8> pixels;   ///< RGBA pixels, row by row
+        unsigned int       width;    ///< Width of the texture, in pixels
+        unsigned int       height;   ///< Height of the texture, in pixels
+        bool               smooth;   ///< Use bilinear filtering?
+        bool               repeated; ///< Repeat the texture outside of its area?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoftwareRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoftwareRasterizer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the color buffer
+    ///
+    /// The contents of the buffer are undefined after resizing,
+    /// and all the pending triangles are discarded.
+    ///
+    /// \param width  New width, in pixels
+    /// \param height New height, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill the whole color buffer with a single color
+    ///
+    /// The pending triangles are discarded, since they would
+    /// be overwritten anyway.
+    ///
+    /// \param color Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a copy of the pixels of a texture
+    ///
+    /// The pixels are downloaded the first time a texture is
+    /// used, and again each time it is modified.
+    ///
+    /// \param texture Texture to copy
+    /// \param version Unique identifier of the current contents of the texture
+    ///
+    /// \return Copy of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    const TextureData* getTextureData(const Texture& texture, Uint64 version);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a new batch of triangles
+    ///
+    /// The triangles added after this call are rendered with
+    /// the given states, until the next batch is started.
+    ///
+    /// \param blendMode Blending mode of the triangles
+    /// \param texture   Texture of the triangles, or NULL
+    /// \param clip      Rectangle, in pixels, outside of which nothing is drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginBatch(const BlendMode& blendMode, const TextureData* texture, const IntRect& clip);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a vertex
+    ///
+    /// \param position  Position of the vertex, in pixels
+    /// \param color     Color of the vertex
+    /// \param texCoords Texture coordinates of the vertex, in pixels
+    ///
+    /// \return Index of the vertex, to be used in addTriangle
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 addVertex(const Vector2f& position, const Color& color, const Vector2f& texCoords);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a triangle to the current batch
+    ///
+    /// \param a Index of the first vertex
+    /// \param b Index of the second vertex
+    /// \param c Index of the third vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    void addTriangle(Uint32 a, Uint32 b, Uint32 c);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize all the pending triangles
+    ///
+    /// The color buffer is split into tiles, which are
+    /// rasterized independently by up to \a threadCount
+    /// threads; the triangles are drawn in order in each tile.
+    ///
+    /// \param threadCount Maximum number of threads to use
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush(unsigned int threadCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color buffer
+    ///
+    /// \return Pointer to the RGBA pixels, row by row
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getPixels() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transformed vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    struct RasterVertex
+    {
+        Int64 x;    ///< X position, in 1/256th of pixel
+        Int64 y;    ///< Y position, in 1/256th of pixel
+        float r;    ///< Red component, from 0 to 1
+        float g;    ///< Green component, from 0 to 1
+        float b;    ///< Blue component, from 0 to 1
+        float a;    ///< Alpha component, from 0 to 1
+        float u;    ///< Horizontal texture coordinate, in pixels
+        float v;    ///< Vertical texture coordinate, in pixels
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render states shared by several triangles
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        BlendMode          blendMode; ///< Blending mode
+        const TextureData* texture;   ///< Texture, or NULL
+        IntRect            clip;      ///< Clipping rectangle, in pixels
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Triangle waiting to be rasterized
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Triangle
+    {
+        Uint32  vertices[3]; ///< Indices of the vertices
+        Uint32  batch;       ///< Index of the batch
+        IntRect bounds;      ///< Pixels that the triangle may cover
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize all the triangles of a range of tiles
+    ///
+    /// \param first First tile to process
+    /// \param step  Difference between two consecutive tiles to process
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeTiles(std::size_t first, std::size_t step);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the part of a triangle which is inside a rectangle
+    ///
+    /// \param triangle Triangle to rasterize
+    /// \param area     Rectangle of pixels to process
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeTriangle(const Triangle& triangle, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of tiles processed by a thread
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TileWorker;
+    friend struct TileWorker;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<const Texture*, std::pair<Uint64, TextureData*> > TextureTable; ///< Textures copies, with the version of the texture they were made from
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int                      m_width;       ///< Width of the color buffer
+    unsigned int                      m_height;      ///< Height of the color buffer
+    std::vector<Uint8>                m_pixels;      ///< Color buffer, RGBA
+    std::vector<RasterVertex>         m_vertices;    ///< Pending vertices
+    std::vector<Batch>                m_batches;     ///< Pending batches
+    std::vector<Triangle>             m_triangles;   ///< Pending triangles
+    std::vector<std::vector<Uint32> > m_tiles;       ///< Pending triangles overlapping each tile, in order
+    unsigned int                      m_tilesPerRow; ///< Number of tiles per row of the color buffer
+    TextureTable                      m_textures;    ///< Copies of the textures used for drawing
+    std::vector<TextureData*>         m_outdated;    ///< Copies replaced by newer ones, which pending triangles may still use
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOFTWARERASTERIZER_HPP
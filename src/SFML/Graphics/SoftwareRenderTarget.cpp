@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SoftwareRenderTarget.hpp>
+#include <SFML/Graphics/SoftwareRasterizer.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+#include <cmath>
+
+
+namespace
+{
+    // Read a vertex, whatever its format
+    sf::Vertex getVertex(const void* vertices, bool compact, std::size_t index)
+    {
+        if (compact)
+        {
+            const sf::CompactVertex& vertex = static_cast<const sf::CompactVertex*>(vertices)[index];
+            return sf::Vertex(sf::Vector2f(vertex.position.x, vertex.position.y),
+                              vertex.color,
+                              sf::Vector2f(vertex.texCoords.x, vertex.texCoords.y));
+        }
+        else
+        {
+            return static_cast<const sf::Vertex*>(vertices)[index];
+        }
+    }
+
+    // Read an index, whatever its size
+    std::size_t getIndex(const void* indices, std::size_t indexSize, std::size_t index)
+    {
+        if (!indices)
+            return index;
+        else if (indexSize == sizeof(sf::Uint16))
+            return static_cast<const sf::Uint16*>(indices)[index];
+        else
+            return static_cast<const sf::Uint32*>(indices)[index];
+    }
+
+    // Feed the rasterizer with triangles, given by their positions in the index array
+    struct TriangleAssembler
+    {
+        void add(std::size_t a, std::size_t b, std::size_t c)
+        {
+            rasterizer->addTriangle(first + static_cast<sf::Uint32>(getIndex(indices, indexSize, a)),
+                                    first + static_cast<sf::Uint32>(getIndex(indices, indexSize, b)),
+                                    first + static_cast<sf::Uint32>(getIndex(indices, indexSize, c)));
+        }
+
+        sf::priv::SoftwareRasterizer* rasterizer;
+        const void*                   indices;
+        std::size_t                   indexSize;
+        sf::Uint32                    first;
+    };
+
+    // Add a quad made of two triangles, with the attributes of a single vertex
+    void addQuad(sf::priv::SoftwareRasterizer& rasterizer, const sf::Vector2f* corners, const sf::Vertex& vertex)
+    {
+        sf::Uint32 indices[4];
+        for (int i = 0; i < 4; ++i)
+            indices[i] = rasterizer.addVertex(corners[i], vertex.color, vertex.texCoords);
+
+        rasterizer.addTriangle(indices[0], indices[1], indices[2]);
+        rasterizer.addTriangle(indices[0], indices[2], indices[3]);
+    }
+
+    // Add a point, as a square of 1 pixel centered on it
+    void addPoint(sf::priv::SoftwareRasterizer& rasterizer, const sf::Vector2f& position, const sf::Vertex& vertex)
+    {
+        sf::Vector2f corners[4] =
+        {
+            sf::Vector2f(position.x - 0.5f, position.y - 0.5f),
+            sf::Vector2f(position.x + 0.5f, position.y - 0.5f),
+            sf::Vector2f(position.x + 0.5f, position.y + 0.5f),
+            sf::Vector2f(position.x - 0.5f, position.y + 0.5f)
+        };
+        addQuad(rasterizer, corners, vertex);
+    }
+
+    // Add a line, as a rectangle of 1 pixel wide with the attributes of its first vertex
+    void addLine(sf::priv::SoftwareRasterizer& rasterizer, const sf::Vector2f& start, const sf::Vector2f& end, const sf::Vertex& vertex)
+    {
+        sf::Vector2f direction = end - start;
+        float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+        if (length == 0.f)
+            return;
+
+        sf::Vector2f normal(-direction.y / length * 0.5f, direction.x / length * 0.5f);
+        sf::Vector2f corners[4] = {start - normal, end - normal, end + normal, start + normal};
+        addQuad(rasterizer, corners, vertex);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoftwareRenderTarget::SoftwareRenderTarget() :
+m_rasterizer (NULL),
+m_image      (),
+m_threadCount(1)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+SoftwareRenderTarget::~SoftwareRenderTarget()
+{
+    delete m_rasterizer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::create(unsigned int width, unsigned int height)
+{
+    if ((width == 0) || (height == 0))
+    {
+        err() << "Failed to create software render target, invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    // Create the rasterizer and its color buffer
+    if (!m_rasterizer)
+        m_rasterizer = new priv::SoftwareRasterizer;
+    m_rasterizer->resize(width, height);
+    m_rasterizer->clear(Color::Black);
+
+    m_image.create(width, height, Color::Black);
+
+    // We can now initialize the render target part
+    RenderTarget::initialize();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::setThreadCount(unsigned int count)
+{
+    m_threadCount = count > 0 ? count : 1;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoftwareRenderTarget::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::clear(const Color& color)
+{
+    if (m_rasterizer)
+        m_rasterizer->clear(color);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::display()
+{
+    if (m_rasterizer)
+    {
+        m_rasterizer->flush(m_threadCount);
+        m_image.create(m_image.getSize().x, m_image.getSize().y, m_rasterizer->getPixels());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u SoftwareRenderTarget::getSize() const
+{
+    return m_image.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& SoftwareRenderTarget::getImage() const
+{
+    return m_image;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::activate(bool)
+{
+    // There's no context to activate
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::drawPrimitives(const void* vertices, std::size_t vertexCount, bool compact, PrimitiveType type, const RenderStates& states,
+                                          const void* indices, std::size_t indexCount, std::size_t indexSize)
+{
+    // Nothing to draw?
+    if (!m_rasterizer || !vertices || (vertexCount == 0) || (indices && (indexCount == 0)))
+        return;
+
+    // Combine the transform of the states with the view, and map
+    // the result from normalized device coordinates to pixels
+    const View& view = getView();
+    IntRect viewport = getViewport(view);
+    float halfWidth  = viewport.width / 2.f;
+    float halfHeight = viewport.height / 2.f;
+    Transform toPixels = Transform(halfWidth, 0.f,         viewport.left + halfWidth,
+                                   0.f,       -halfHeight, viewport.top + halfHeight,
+                                   0.f,       0.f,         1.f) * view.getTransform() * states.transform;
+
+    // Restrict the drawing area to the scissor rectangle, if any
+    IntRect clip = viewport;
+    if (states.scissorEnabled && !viewport.intersects(states.scissor, clip))
+        return;
+
+    // Copy the texture, if any
+    const priv::SoftwareRasterizer::TextureData* texture = NULL;
+    if (states.texture)
+        texture = m_rasterizer->getTextureData(*states.texture, states.texture->m_cacheId);
+
+    m_rasterizer->beginBatch(states.blendMode, texture, clip);
+
+    std::size_t count = indices ? indexCount : vertexCount;
+
+    // Points and lines are expanded to quads of 1 pixel wide
+    if ((type == Points) || (type == Lines) || (type == LinesStrip))
+    {
+        if (type == Points)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Vertex vertex = getVertex(vertices, compact, getIndex(indices, indexSize, i));
+                addPoint(*m_rasterizer, toPixels.transformPoint(vertex.position), vertex);
+            }
+        }
+        else
+        {
+            std::size_t step = (type == Lines) ? 2 : 1;
+            for (std::size_t i = 0; i + 1 < count; i += step)
+            {
+                Vertex start = getVertex(vertices, compact, getIndex(indices, indexSize, i));
+                Vertex end   = getVertex(vertices, compact, getIndex(indices, indexSize, i + 1));
+                addLine(*m_rasterizer, toPixels.transformPoint(start.position), toPixels.transformPoint(end.position), start);
+            }
+        }
+
+        return;
+    }
+
+    // Transform the vertices once, and store them in the rasterizer
+    Uint32 first = 0;
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        Vertex vertex = getVertex(vertices, compact, i);
+        Uint32 index = m_rasterizer->addVertex(toPixels.transformPoint(vertex.position), vertex.color, vertex.texCoords);
+        if (i == 0)
+            first = index;
+    }
+
+    // Assemble the triangles
+    TriangleAssembler assembler = {m_rasterizer, indices, indexSize, first};
+    switch (type)
+    {
+        case Triangles:
+        {
+            for (std::size_t i = 0; i + 2 < count; i += 3)
+                assembler.add(i, i + 1, i + 2);
+            break;
+        }
+
+        case TrianglesStrip:
+        {
+            for (std::size_t i = 0; i + 2 < count; ++i)
+                assembler.add(i, i + 1, i + 2);
+            break;
+        }
+
+        case TrianglesFan:
+        {
+            for (std::size_t i = 1; i + 1 < count; ++i)
+                assembler.add(0, i, i + 1);
+            break;
+        }
+
+        case Quads:
+        {
+            for (std::size_t i = 0; i + 3 < count; i += 4)
+            {
+                assembler.add(i, i + 1, i + 2);
+                assembler.add(i, i + 2, i + 3);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+} // namespace sf
@@ -28,9 +28,80 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
 #include <cmath>
 
 
+namespace
+{
+    sf::Mutex mutex;
+
+    // Number of quads drawn at once, so that their indices fit on 16 bits
+    const std::size_t quadsPerBatch = 16384;
+
+    // Fragment shader drawing the glyphs of a distance field texture;
+    // the anti-aliasing width is derived from the screen-space derivatives
+    // of the field, so that edges stay crisp at any scale
+    const char* distanceFieldSource =
+        "uniform sampler2D texture;"
+        "uniform float threshold;"
+        "void main()"
+        "{"
+        "    float distance = texture2D(texture, gl_TexCoord[0].xy).a;"
+        "    float smoothing = 0.5 * fwidth(distance);"
+        "    float alpha = smoothstep(threshold - smoothing, threshold + smoothing, distance);"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);"
+        "}";
+
+    // Get the shared distance field shader, NULL if shaders are not supported
+    sf::Shader* getDistanceFieldShader()
+    {
+        sf::Lock lock(mutex);
+
+        static bool loaded = false;
+        static sf::Shader* shader = NULL;
+
+        if (!loaded)
+        {
+            loaded = true;
+
+            // The shader is intentionally never destroyed, as static
+            // destruction may happen after the last OpenGL context is gone
+            if (sf::Shader::isAvailable())
+            {
+                shader = new sf::Shader;
+                if (shader->loadFromMemory(distanceFieldSource, sf::Shader::Fragment))
+                {
+                    shader->setParameter("texture", sf::Shader::CurrentTexture);
+                }
+                else
+                {
+                    delete shader;
+                    shader = NULL;
+                }
+            }
+        }
+
+        return shader;
+    }
+
+    // Get a glyph from a font, either rasterized for the character size or as a distance field
+    const sf::Glyph& getGlyph(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize, bool bold, bool distanceField)
+    {
+        return distanceField ? font.getDistanceFieldGlyph(codePoint) : font.getGlyph(codePoint, characterSize, bold);
+    }
+
+    // Get the metrics of a glyph, without rasterizing it unless it is a distance field glyph
+    const sf::Glyph& getGlyphMetrics(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize, bool bold, bool distanceField)
+    {
+        return distanceField ? font.getDistanceFieldGlyph(codePoint) : font.getGlyphMetrics(codePoint, characterSize, bold);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -40,9 +111,12 @@ m_font              (NULL),
 m_characterSize     (30),
 m_style             (Regular),
 m_color             (255, 255, 255),
+m_distanceField     (false),
 m_vertices          (Triangles),
+m_indices           (),
 m_bounds            (),
-m_geometryNeedUpdate(false)
+m_geometryNeedUpdate(false),
+m_firstChangedChar  (0)
 {
 
 }
@@ -55,9 +129,12 @@ m_font              (&font),
 m_characterSize     (characterSize),
 m_style             (Regular),
 m_color             (255, 255, 255),
+m_distanceField     (false),
 m_vertices          (Triangles),
+m_indices           (),
 m_bounds            (),
-m_geometryNeedUpdate(true)
+m_geometryNeedUpdate(true),
+m_firstChangedChar  (0)
 {
 
 }
@@ -68,8 +145,14 @@ void Text::setString(const String& string)
 {
     if (m_string != string)
     {
+        // Find the first character that differs, the geometry before it can be kept
+        std::size_t index = 0;
+        std::size_t count = std::min(m_string.getSize(), string.getSize());
+        while ((index < count) && (m_string[index] == string[index]))
+            ++index;
+
         m_string = string;
-        m_geometryNeedUpdate = true;
+        invalidateGeometry(index);
     }
 }
 
@@ -80,7 +163,7 @@ void Text::setFont(const Font& font)
     if (m_font != &font)
     {
         m_font = &font;
-        m_geometryNeedUpdate = true;
+        invalidateGeometry(0);
     }
 }
 
@@ -91,7 +174,7 @@ void Text::setCharacterSize(unsigned int size)
     if (m_characterSize != size)
     {
         m_characterSize = size;
-        m_geometryNeedUpdate = true;
+        invalidateGeometry(0);
     }
 }
 
@@ -102,7 +185,7 @@ void Text::setStyle(Uint32 style)
     if (m_style != style)
     {
         m_style = style;
-        m_geometryNeedUpdate = true;
+        invalidateGeometry(0);
     }
 }
 
@@ -115,8 +198,8 @@ void Text::setColor(const Color& color)
         m_color = color;
 
         // Change vertex colors directly, no need to update whole geometry
-        // (if geometry is updated anyway, we can skip this step)
-        if (!m_geometryNeedUpdate)
+        // (if the whole geometry is rebuilt anyway, we can skip this step)
+        if (!m_geometryNeedUpdate || (m_firstChangedChar > 0))
         {
             for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
                 m_vertices[i].color = m_color;
@@ -125,6 +208,17 @@ void Text::setColor(const Color& color)
 }
 
 
+////////////////////////////////////////////////////////////
+void Text::setDistanceFieldEnabled(bool enabled)
+{
+    if (m_distanceField != enabled)
+    {
+        m_distanceField = enabled;
+        invalidateGeometry(0);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 const String& Text::getString() const
 {
@@ -160,6 +254,13 @@ const Color& Text::getColor() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Text::isDistanceFieldEnabled() const
+{
+    return m_distanceField;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2f Text::findCharacterPos(std::size_t index) const
 {
@@ -172,9 +273,12 @@ Vector2f Text::findCharacterPos(std::size_t index) const
         index = m_string.getSize();
 
     // Precompute the variables needed by the algorithm
-    bool  bold   = (m_style & Bold) != 0;
-    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
-    float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
+    bool  bold          = (m_style & Bold) != 0;
+    bool  distanceField = m_distanceField && getDistanceFieldShader();
+    float scale         = distanceField ? static_cast<float>(m_characterSize) / Font::DistanceFieldSize : 1.f;
+    float boldAdvance   = (distanceField && bold) ? 1.f : 0.f;
+    float hspace        = getGlyphMetrics(*m_font, L' ', m_characterSize, bold, distanceField).advance * scale + boldAdvance;
+    float vspace        = static_cast<float>(m_font->getLineSpacing(m_characterSize));
 
     // Compute the position
     Vector2f position;
@@ -196,7 +300,7 @@ Vector2f Text::findCharacterPos(std::size_t index) const
         }
 
         // For regular characters, add the advance offset of the glyph
-        position.x += static_cast<float>(m_font->getGlyph(curChar, m_characterSize, bold).advance);
+        position.x += getGlyphMetrics(*m_font, curChar, m_characterSize, bold, distanceField).advance * scale + boldAdvance;
     }
 
     // Transform the position to global coordinates
@@ -230,12 +334,50 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         ensureGeometryUpdate();
 
         states.transform *= getTransform();
-        states.texture = &m_font->getTexture(m_characterSize);
-        target.draw(m_vertices, states);
+
+        Shader* shader = m_distanceField ? getDistanceFieldShader() : NULL;
+        if (shader)
+        {
+            states.texture = &m_font->getDistanceFieldTexture();
+
+            if (!states.shader)
+            {
+                // Lower the threshold for the bold style, so that outlines get
+                // about half a pixel thicker on each side at the character size
+                float threshold = 0.5f;
+                if (m_style & Bold)
+                    threshold -= 0.25f * Font::DistanceFieldSize / (static_cast<float>(m_characterSize) * Font::DistanceFieldSpread);
+
+                shader->setParameter("threshold", threshold);
+                states.shader = shader;
+            }
+        }
+        else
+        {
+            states.texture = &m_font->getTexture(m_characterSize);
+        }
+
+        // Draw the quads by batches which all share the same indices
+        std::size_t quadCount = m_vertices.getVertexCount() / 4;
+        for (std::size_t first = 0; first < quadCount; first += quadsPerBatch)
+        {
+            std::size_t count = std::min(quadsPerBatch, quadCount - first);
+            target.draw(&m_vertices[first * 4], count * 4, &m_indices[0], count * 6, Triangles, states);
+        }
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Text::invalidateGeometry(std::size_t index)
+{
+    if (!m_geometryNeedUpdate || (index < m_firstChangedChar))
+        m_firstChangedChar = index;
+
+    m_geometryNeedUpdate = true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Text::ensureGeometryUpdate() const
 {
@@ -246,17 +388,14 @@ void Text::ensureGeometryUpdate() const
     // Mark geometry as updated
     m_geometryNeedUpdate = false;
 
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_bounds = FloatRect();
-
-    // No font: nothing to draw
-    if (!m_font)
-        return;
-
-    // No text: nothing to draw
-    if (m_string.isEmpty())
+    // No font or no text: nothing to draw
+    if (!m_font || m_string.isEmpty())
+    {
+        m_vertices.clear();
+        m_lines.clear();
+        m_bounds = FloatRect();
         return;
+    }
 
     // Compute values related to the text style
     bool  bold               = (m_style & Bold) != 0;
@@ -266,27 +405,67 @@ void Text::ensureGeometryUpdate() const
     float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
     float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
 
+    // Distance field glyphs are defined for a reference size: scale them, draw them with
+    // their surrounding field (so that the shader can widen them) and emulate the extra
+    // advance of bold glyphs
+    bool  distanceField = m_distanceField && getDistanceFieldShader();
+    float scale         = distanceField ? static_cast<float>(m_characterSize) / Font::DistanceFieldSize : 1.f;
+    float margin        = distanceField ? static_cast<float>(Font::DistanceFieldSpread) : 0.f;
+    float boldAdvance   = (distanceField && bold) ? 1.f : 0.f;
+
     // Compute the location of the strike through dynamically
     // We use the center point of the lowercase 'x' glyph as the reference
     // We reuse the underline thickness as the thickness of the strike through as well
-    FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, bold).bounds;
-    float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+    FloatRect xBounds = getGlyph(*m_font, L'x', m_characterSize, bold, distanceField).bounds;
+    float strikeThroughOffset = (xBounds.top + xBounds.height / 2.f) * scale;
 
     // Precompute the variables needed by the algorithm
-    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
+    float hspace = getGlyph(*m_font, L' ', m_characterSize, bold, distanceField).advance * scale + boldAdvance;
     float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
-    float x      = 0.f;
-    float y      = static_cast<float>(m_characterSize);
 
-    // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
+    // Find the line containing the first changed character: the lines before it
+    // are kept as they are, the geometry is rebuilt from its beginning
+    std::size_t lineCount = 0;
+    std::size_t first = 0;
+    std::size_t last  = m_lines.size();
+    while (first < last)
+    {
+        std::size_t middle = (first + last) / 2;
+        if (m_lines[middle].firstChar <= m_firstChangedChar)
+        {
+            lineCount = middle;
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    float  x        = 0.f;
+    float  y        = static_cast<float>(m_characterSize);
     Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    std::size_t start = 0;
+    if (lineCount < m_lines.size())
+    {
+        start = m_lines[lineCount].firstChar;
+        y     = m_lines[lineCount].y;
+        m_vertices.resize(m_lines[lineCount].firstVertex);
+        if (start > 0)
+            prevChar = m_string[start - 1];
+    }
+    else
+    {
+        m_vertices.clear();
+    }
+    m_lines.erase(m_lines.begin() + lineCount, m_lines.end());
+
+    // Create one quad for each character
+    m_lines.push_back(Line(start, m_vertices.getVertexCount(), y));
+    for (std::size_t i = start; i < m_string.getSize(); ++i)
     {
         Uint32 curChar = m_string[i];
+        Line&  line    = m_lines.back();
 
         // Apply the kerning offset
         x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
@@ -301,8 +480,6 @@ void Text::ensureGeometryUpdate() const
             m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
             m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
             m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
             m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
         }
 
@@ -315,8 +492,6 @@ void Text::ensureGeometryUpdate() const
             m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
             m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
             m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
             m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
         }
 
@@ -324,8 +499,8 @@ void Text::ensureGeometryUpdate() const
         if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
         {
             // Update the current bounds (min coordinates)
-            minX = std::min(minX, x);
-            minY = std::min(minY, y);
+            line.minX = std::min(line.minX, x);
+            line.minY = std::min(line.minY, y);
 
             switch (curChar)
             {
@@ -335,42 +510,45 @@ void Text::ensureGeometryUpdate() const
             }
 
             // Update the current bounds (max coordinates)
-            maxX = std::max(maxX, x);
-            maxY = std::max(maxY, y);
+            line.maxX = std::max(line.maxX, x);
+            line.maxY = std::max(line.maxY, y);
+
+            // Start a new line after a line break
+            if (curChar == '\n')
+                m_lines.push_back(Line(i + 1, m_vertices.getVertexCount(), y));
 
             // Next glyph, no need to create a quad for whitespace
             continue;
         }
 
         // Extract the current glyph's description
-        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
+        const Glyph& glyph = getGlyph(*m_font, curChar, m_characterSize, bold, distanceField);
 
-        float left   = glyph.bounds.left;
-        float top    = glyph.bounds.top;
-        float right  = glyph.bounds.left + glyph.bounds.width;
-        float bottom = glyph.bounds.top  + glyph.bounds.height;
+        float left   = (glyph.bounds.left - margin) * scale;
+        float top    = (glyph.bounds.top - margin) * scale;
+        float right  = (glyph.bounds.left + glyph.bounds.width + margin) * scale;
+        float bottom = (glyph.bounds.top  + glyph.bounds.height + margin) * scale;
 
-        float u1 = static_cast<float>(glyph.textureRect.left);
-        float v1 = static_cast<float>(glyph.textureRect.top);
-        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
-        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
+        float u1 = static_cast<float>(glyph.textureRect.left) - margin;
+        float v1 = static_cast<float>(glyph.textureRect.top) - margin;
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + margin;
+        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height) + margin;
 
         // Add a quad for the current character
         m_vertices.append(Vertex(Vector2f(x + left  - italic * top,    y + top),    m_color, Vector2f(u1, v1)));
         m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
         m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
         m_vertices.append(Vertex(Vector2f(x + right - italic * bottom, y + bottom), m_color, Vector2f(u2, v2)));
 
-        // Update the current bounds
-        minX = std::min(minX, x + left - italic * bottom);
-        maxX = std::max(maxX, x + right - italic * top);
-        minY = std::min(minY, y + top);
-        maxY = std::max(maxY, y + bottom);
+        // Update the current bounds (the margin of distance field glyphs is excluded)
+        float padding = margin * scale;
+        line.minX = std::min(line.minX, x + left + padding - italic * (bottom - padding));
+        line.maxX = std::max(line.maxX, x + right - padding - italic * (top + padding));
+        line.minY = std::min(line.minY, y + top + padding);
+        line.maxY = std::max(line.maxY, y + bottom - padding);
 
         // Advance to the next character
-        x += glyph.advance;
+        x += glyph.advance * scale + boldAdvance;
     }
 
     // If we're using the underlined style, add the last line
@@ -382,8 +560,6 @@ void Text::ensureGeometryUpdate() const
         m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
         m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
         m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
         m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
     }
 
@@ -396,11 +572,36 @@ void Text::ensureGeometryUpdate() const
         m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
         m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
         m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
         m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
     }
 
+    // Two triangles per quad, in the same order as IndexArray::appendQuad; the indices
+    // of a batch of quads are shared by all the batches, so they are only extended
+    std::size_t quads = std::min(m_vertices.getVertexCount() / 4, quadsPerBatch);
+    for (std::size_t i = m_indices.size() / 6; i < quads; ++i)
+    {
+        Uint16 first = static_cast<Uint16>(i * 4);
+        m_indices.push_back(first + 0);
+        m_indices.push_back(first + 1);
+        m_indices.push_back(first + 2);
+        m_indices.push_back(first + 2);
+        m_indices.push_back(first + 1);
+        m_indices.push_back(first + 3);
+    }
+
+    // Merge the bounds of all the lines
+    float minX = static_cast<float>(m_characterSize);
+    float minY = static_cast<float>(m_characterSize);
+    float maxX = 0.f;
+    float maxY = 0.f;
+    for (std::vector<Line>::const_iterator it = m_lines.begin(); it != m_lines.end(); ++it)
+    {
+        minX = std::min(minX, it->minX);
+        minY = std::min(minY, it->minY);
+        maxX = std::max(maxX, it->maxX);
+        maxY = std::max(maxY, it->maxY);
+    }
+
     // Update the bounding rectangle
     m_bounds.left = minX;
     m_bounds.top = minY;
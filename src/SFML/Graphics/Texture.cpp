@@ -415,6 +415,62 @@ void Texture::update(const Image& image, unsigned int x, unsigned int y)
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
+{
+    assert(x + texture.m_size.x <= m_size.x);
+    assert(y + texture.m_size.y <= m_size.y);
+
+    if (!m_texture || !texture.m_texture)
+        return;
+
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    // Flipped sources would need a per-row copy, let the image path handle them
+    if (GLEXT_framebuffer_object && !texture.m_pixelsFlipped)
+    {
+        GLint previousFrameBuffer;
+        glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
+
+        // Attach the source texture to a temporary FBO, so that it can be read directly by glCopyTexSubImage2D
+        GLuint frameBuffer = 0;
+        glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
+        if (frameBuffer)
+        {
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+            glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.m_texture, 0));
+
+            GLenum status;
+            glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+            if (status == GLEXT_GL_FRAMEBUFFER_COMPLETE)
+            {
+                // Make sure that the current texture binding will be preserved
+                priv::TextureSaver save;
+
+                glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+                glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 0, 0, texture.m_size.x, texture.m_size.y));
+            }
+
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
+            glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+
+            if (status == GLEXT_GL_FRAMEBUFFER_COMPLETE)
+            {
+                m_pixelsFlipped = false;
+                m_cacheId = getUniqueId();
+                return;
+            }
+        }
+    }
+
+    // Slow path: go through the system memory
+    update(texture.copyToImage(), x, y);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Window& window)
 {
@@ -602,6 +658,22 @@ Texture& Texture::operator =(const Texture& right)
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::swap(Texture& right)
+{
+    std::swap(m_size,          right.m_size);
+    std::swap(m_actualSize,    right.m_actualSize);
+    std::swap(m_texture,       right.m_texture);
+    std::swap(m_isSmooth,      right.m_isSmooth);
+    std::swap(m_isRepeated,    right.m_isRepeated);
+    std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
+    std::swap(m_fboAttachment, right.m_fboAttachment);
+
+    m_cacheId = getUniqueId();
+    right.m_cacheId = getUniqueId();
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getNativeHandle() const
 {
@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Number of tiles of a chunk in each direction; 32x32 tiles need
+    // 4096 vertices, which 16-bit indices can address
+    const unsigned int tilesPerChunk = 32;
+
+    // Number of chunks around the visible ones which are kept in the cache
+    const unsigned int chunkCacheMargin = 1;
+
+    // Convert a coordinate to a chunk index, clamped to the range of the map
+    unsigned int toChunk(float coordinate, float chunkSize, unsigned int chunkCount)
+    {
+        float chunk = std::floor(coordinate / chunkSize);
+        if (chunk < 0.f)
+            return 0;
+
+        return std::min(static_cast<unsigned int>(chunk), chunkCount - 1);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const Uint16 TileMap::EmptyTile = 0xFFFF;
+
+
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_size    (0, 0),
+m_tileSize(0, 0),
+m_tiles   (),
+m_texture (NULL),
+m_columns (1),
+m_indices (),
+m_chunks  ()
+{
+    // All the chunks have the same layout, so they can share their indices
+    m_indices.resize(tilesPerChunk * tilesPerChunk * 6);
+    for (std::size_t i = 0; i < tilesPerChunk * tilesPerChunk; ++i)
+    {
+        Uint16 first = static_cast<Uint16>(i * 4);
+        m_indices[i * 6 + 0] = first + 0;
+        m_indices[i * 6 + 1] = first + 1;
+        m_indices[i * 6 + 2] = first + 2;
+        m_indices[i * 6 + 3] = first + 2;
+        m_indices[i * 6 + 4] = first + 1;
+        m_indices[i * 6 + 5] = first + 3;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::create(const Vector2u& size, const Vector2u& tileSize, Uint16 tile)
+{
+    m_size = size;
+    m_tileSize = tileSize;
+    m_tiles.assign(static_cast<std::size_t>(size.x) * size.y, tile);
+
+    // Update the layout of the tileset
+    setTexture(m_texture);
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& TileMap::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTexture(const Texture* texture)
+{
+    m_texture = texture;
+    m_columns = 1;
+    if (m_texture && (m_tileSize.x > 0))
+        m_columns = std::max(m_texture->getSize().x / m_tileSize.x, 1u);
+
+    // The texture coordinates of all the tiles change
+    m_chunks.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int x, unsigned int y, Uint16 tile)
+{
+    m_tiles[static_cast<std::size_t>(y) * m_size.x + x] = tile;
+
+    // Update the tile in place if its chunk is cached
+    std::size_t chunksPerRow = (m_size.x + tilesPerChunk - 1) / tilesPerChunk;
+    ChunkTable::iterator chunk = m_chunks.find((y / tilesPerChunk) * chunksPerRow + x / tilesPerChunk);
+    if (chunk != m_chunks.end())
+    {
+        std::size_t index = (y % tilesPerChunk) * tilesPerChunk + x % tilesPerChunk;
+        writeTile(x, y, &chunk->second[index * 4]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint16 TileMap::getTile(unsigned int x, unsigned int y) const
+{
+    return m_tiles[static_cast<std::size_t>(y) * m_size.x + x];
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTiles(const Uint16* tiles)
+{
+    std::copy(tiles, tiles + m_tiles.size(), m_tiles.begin());
+    m_chunks.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_size.x * m_tileSize.x), static_cast<float>(m_size.y * m_tileSize.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_tiles.empty() || (m_tileSize.x == 0) || (m_tileSize.y == 0))
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    // Compute the area of the view in local coordinates
+    const View& view = target.getView();
+    FloatRect viewArea = view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    FloatRect area = states.transform.getInverse().transformRect(viewArea);
+    if (!area.intersects(getLocalBounds()))
+        return;
+
+    // Find the range of visible chunks
+    float chunkWidth  = static_cast<float>(m_tileSize.x * tilesPerChunk);
+    float chunkHeight = static_cast<float>(m_tileSize.y * tilesPerChunk);
+    unsigned int chunksPerRow    = (m_size.x + tilesPerChunk - 1) / tilesPerChunk;
+    unsigned int chunksPerColumn = (m_size.y + tilesPerChunk - 1) / tilesPerChunk;
+    unsigned int left   = toChunk(area.left, chunkWidth, chunksPerRow);
+    unsigned int top    = toChunk(area.top, chunkHeight, chunksPerColumn);
+    unsigned int right  = toChunk(area.left + area.width, chunkWidth, chunksPerRow);
+    unsigned int bottom = toChunk(area.top + area.height, chunkHeight, chunksPerColumn);
+
+    // Drop the cached chunks which are too far from the view
+    ChunkTable::iterator it = m_chunks.begin();
+    while (it != m_chunks.end())
+    {
+        unsigned int x = static_cast<unsigned int>(it->first % chunksPerRow);
+        unsigned int y = static_cast<unsigned int>(it->first / chunksPerRow);
+        if ((x + chunkCacheMargin < left) || (x > right + chunkCacheMargin) ||
+            (y + chunkCacheMargin < top)  || (y > bottom + chunkCacheMargin))
+            m_chunks.erase(it++);
+        else
+            ++it;
+    }
+
+    // Generate the missing visible chunks, and draw them
+    for (unsigned int y = top; y <= bottom; ++y)
+    {
+        for (unsigned int x = left; x <= right; ++x)
+        {
+            std::size_t index = static_cast<std::size_t>(y) * chunksPerRow + x;
+            ChunkTable::iterator chunk = m_chunks.find(index);
+            if (chunk == m_chunks.end())
+            {
+                chunk = m_chunks.insert(std::make_pair(index, std::vector<Vertex>())).first;
+                buildChunk(x, y, chunk->second);
+            }
+
+            target.draw(&chunk->second[0], chunk->second.size(), &m_indices[0], m_indices.size(), Triangles, states);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::buildChunk(unsigned int chunkX, unsigned int chunkY, std::vector<Vertex>& vertices) const
+{
+    // Chunks on the borders have the same layout as the others; their
+    // tiles which are out of the map are left empty
+    vertices.resize(tilesPerChunk * tilesPerChunk * 4);
+
+    unsigned int firstX = chunkX * tilesPerChunk;
+    unsigned int firstY = chunkY * tilesPerChunk;
+    unsigned int endX   = std::min(firstX + tilesPerChunk, m_size.x);
+    unsigned int endY   = std::min(firstY + tilesPerChunk, m_size.y);
+
+    for (unsigned int y = firstY; y < endY; ++y)
+    {
+        Vertex* quad = &vertices[(y - firstY) * tilesPerChunk * 4];
+        for (unsigned int x = firstX; x < endX; ++x, quad += 4)
+            writeTile(x, y, quad);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::writeTile(unsigned int x, unsigned int y, Vertex* quad) const
+{
+    float left   = static_cast<float>(x * m_tileSize.x);
+    float top    = static_cast<float>(y * m_tileSize.y);
+    float right  = left + m_tileSize.x;
+    float bottom = top + m_tileSize.y;
+
+    Uint16 tile = m_tiles[static_cast<std::size_t>(y) * m_size.x + x];
+    if (tile == EmptyTile)
+    {
+        // Empty tiles are collapsed to a point, so that they produce no pixel
+        quad[0].position = quad[1].position = quad[2].position = quad[3].position = Vector2f(left, top);
+        return;
+    }
+
+    float u = static_cast<float>((tile % m_columns) * m_tileSize.x);
+    float v = static_cast<float>((tile / m_columns) * m_tileSize.y);
+    float w = static_cast<float>(m_tileSize.x);
+    float h = static_cast<float>(m_tileSize.y);
+
+    quad[0] = Vertex(Vector2f(left, top),     Vector2f(u, v));
+    quad[1] = Vertex(Vector2f(right, top),    Vector2f(u + w, v));
+    quad[2] = Vertex(Vector2f(left, bottom),  Vector2f(u, v + h));
+    quad[3] = Vertex(Vector2f(right, bottom), Vector2f(u + w, v + h));
+}
+
+} // namespace sf
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
+#include <algorithm>
 #include <cmath>
 
 
@@ -112,29 +113,71 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
-    // Transform the 4 corners of the rectangle
-    const Vector2f points[] =
-    {
-        transformPoint(rectangle.left, rectangle.top),
-        transformPoint(rectangle.left, rectangle.top + rectangle.height),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top + rectangle.height)
-    };
-
-    // Compute the bounding rectangle of the transformed points
-    float left = points[0].x;
-    float top = points[0].y;
-    float right = points[0].x;
-    float bottom = points[0].y;
-    for (int i = 1; i < 4; ++i)
+    FloatRect result;
+    transformRects(&rectangle, &result, 1);
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* points, Vector2f* result, std::size_t count) const
+{
+    // Like transformPoint, only use the 2x3 affine part of the matrix;
+    // keeping it in locals lets the compiler vectorize the loop
+    const float a00 = m_matrix[0];
+    const float a01 = m_matrix[4];
+    const float a02 = m_matrix[12];
+    const float a10 = m_matrix[1];
+    const float a11 = m_matrix[5];
+    const float a12 = m_matrix[13];
+
+    for (std::size_t i = 0; i < count; ++i)
     {
-        if      (points[i].x < left)   left = points[i].x;
-        else if (points[i].x > right)  right = points[i].x;
-        if      (points[i].y < top)    top = points[i].y;
-        else if (points[i].y > bottom) bottom = points[i].y;
+        float x = points[i].x;
+        float y = points[i].y;
+        result[i].x = a00 * x + a01 * y + a02;
+        result[i].y = a10 * x + a11 * y + a12;
     }
+}
+
 
-    return FloatRect(left, top, right - left, bottom - top);
+////////////////////////////////////////////////////////////
+void Transform::transformRects(const FloatRect* rectangles, FloatRect* result, std::size_t count) const
+{
+    const float a00 = m_matrix[0];
+    const float a01 = m_matrix[4];
+    const float a02 = m_matrix[12];
+    const float a10 = m_matrix[1];
+    const float a11 = m_matrix[5];
+    const float a12 = m_matrix[13];
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float left   = rectangles[i].left;
+        float top    = rectangles[i].top;
+        float right  = left + rectangles[i].width;
+        float bottom = top + rectangles[i].height;
+
+        // Each coordinate of a transformed corner is a sum of one term depending
+        // on x and one depending on y, so the extremes of the 4 corners are
+        // given by the extremes of each term, without transforming the corners
+        float x0 = a00 * left;
+        float x1 = a00 * right;
+        float x2 = a01 * top;
+        float x3 = a01 * bottom;
+        float y0 = a10 * left;
+        float y1 = a10 * right;
+        float y2 = a11 * top;
+        float y3 = a11 * bottom;
+
+        float minX = std::min(x0, x1) + std::min(x2, x3) + a02;
+        float maxX = std::max(x0, x1) + std::max(x2, x3) + a02;
+        float minY = std::min(y0, y1) + std::min(y2, y3) + a12;
+        float maxY = std::max(y0, y1) + std::max(y2, y3) + a12;
+
+        result[i] = FloatRect(minX, minY, maxX - minX, maxY - minY);
+    }
 }
 
 
@@ -144,6 +187,22 @@ Transform& Transform::combine(const Transform& transform)
     const float* a = m_matrix;
     const float* b = transform.m_matrix;
 
+    if (isAffine() && transform.isAffine())
+    {
+        // Only the 2x3 affine parts need to be multiplied
+        float a00 = a[0] * b[0]  + a[4] * b[1];
+        float a01 = a[0] * b[4]  + a[4] * b[5];
+        float a02 = a[0] * b[12] + a[4] * b[13] + a[12];
+        float a10 = a[1] * b[0]  + a[5] * b[1];
+        float a11 = a[1] * b[4]  + a[5] * b[5];
+        float a12 = a[1] * b[12] + a[5] * b[13] + a[13];
+
+        m_matrix[0] = a00; m_matrix[4] = a01; m_matrix[12] = a02;
+        m_matrix[1] = a10; m_matrix[5] = a11; m_matrix[13] = a12;
+
+        return *this;
+    }
+
     *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
                       a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
                       a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
@@ -269,4 +328,11 @@ Vector2f operator *(const Transform& left, const Vector2f& right)
     return left.transformPoint(right);
 }
 
+
+////////////////////////////////////////////////////////////
+bool Transform::isAffine() const
+{
+    return (m_matrix[3] == 0.f) && (m_matrix[7] == 0.f) && (m_matrix[15] == 1.f);
+}
+
 } // namespace sf
@@ -58,6 +58,7 @@ void Transformable::setPosition(float x, float y)
     m_position.y = y;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+    onTransformChange();
 }
 
 
@@ -77,6 +78,7 @@ void Transformable::setRotation(float angle)
 
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+    onTransformChange();
 }
 
 
@@ -87,6 +89,7 @@ void Transformable::setScale(float factorX, float factorY)
     m_scale.y = factorY;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+    onTransformChange();
 }
 
 
@@ -104,6 +107,7 @@ void Transformable::setOrigin(float x, float y)
     m_origin.y = y;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+    onTransformChange();
 }
 
 
@@ -216,4 +220,11 @@ const Transform& Transformable::getInverseTransform() const
     return m_inverseTransform;
 }
 
+
+////////////////////////////////////////////////////////////
+void Transformable::onTransformChange()
+{
+    // Nothing to do by default
+}
+
 } // namespace sf
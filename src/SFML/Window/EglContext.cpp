@@ -39,9 +39,46 @@
 #ifdef SFML_SYSTEM_LINUX
     #include <X11/Xlib.h>
 #endif
+#include <vector>
+#include <cstring>
+
+#if !defined(EGL_BUFFER_AGE_EXT)
+    #define EGL_BUFFER_AGE_EXT 0x313D
+#endif
 
 namespace
 {
+    typedef EGLBoolean (EGLAPIENTRY *SwapBuffersWithDamageFuncType)(EGLDisplay, EGLSurface, EGLint*, EGLint);
+
+    // Check if an extension is supported by a display
+    bool hasExtension(EGLDisplay display, const char* name)
+    {
+        const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+        if (!extensions)
+            return false;
+
+        std::size_t length = std::strlen(name);
+        for (const char* start = std::strstr(extensions, name); start; start = std::strstr(start + length, name))
+        {
+            if (((start == extensions) || (start[-1] == ' ')) && ((start[length] == ' ') || (start[length] == '\0')))
+                return true;
+        }
+
+        return false;
+    }
+
+    // Get the swap-with-damage entry point of a display, either the KHR or the EXT variant
+    SwapBuffersWithDamageFuncType getSwapBuffersWithDamage(EGLDisplay display)
+    {
+        if (hasExtension(display, "EGL_KHR_swap_buffers_with_damage"))
+            return reinterpret_cast<SwapBuffersWithDamageFuncType>(eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+
+        if (hasExtension(display, "EGL_EXT_swap_buffers_with_damage"))
+            return reinterpret_cast<SwapBuffersWithDamageFuncType>(eglGetProcAddress("eglSwapBuffersWithDamageEXT"));
+
+        return NULL;
+    }
+
     EGLDisplay getInitializedDisplay()
     {
 #if defined(SFML_SYSTEM_LINUX)
@@ -185,6 +222,43 @@ void EglContext::display()
 }
 
 
+////////////////////////////////////////////////////////////
+void EglContext::displayDamage(const int* rectangles, std::size_t count)
+{
+    if (m_surface == EGL_NO_SURFACE)
+        return;
+
+    static SwapBuffersWithDamageFuncType swapBuffersWithDamage = getSwapBuffersWithDamage(m_display);
+
+    if (swapBuffersWithDamage && (count > 0))
+    {
+        std::vector<EGLint> damage(rectangles, rectangles + count * 4);
+        eglCheck(swapBuffersWithDamage(m_display, m_surface, &damage[0], static_cast<EGLint>(count)));
+    }
+    else
+    {
+        eglCheck(eglSwapBuffers(m_display, m_surface));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int EglContext::getBufferAge()
+{
+    static bool hasBufferAge = hasExtension(m_display, "EGL_EXT_buffer_age");
+
+    if ((m_surface == EGL_NO_SURFACE) || !hasBufferAge)
+        return 0;
+
+    // A failed query only means that the age is unknown
+    EGLint age = 0;
+    if (!eglQuerySurface(m_display, m_surface, EGL_BUFFER_AGE_EXT, &age) || (age < 0))
+        return 0;
+
+    return static_cast<unsigned int>(age);
+}
+
+
 ////////////////////////////////////////////////////////////
 void EglContext::setVerticalSyncEnabled(bool enabled)
 {
@@ -94,6 +94,25 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void display();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display the back buffer, hinting which parts of it changed
+    ///
+    /// Uses EGL_KHR/EXT_swap_buffers_with_damage when available.
+    ///
+    /// \param rectangles Array of 4 * \a count integers (x, y, width, height)
+    /// \param count      Number of rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void displayDamage(const int* rectangles, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the back buffer
+    ///
+    /// \return Age of the back buffer (EGL_EXT_buffer_age), 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBufferAge();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable vertical synchronization
     ///
@@ -47,6 +47,13 @@
         #include <SFML/Window/Unix/GlxContext.hpp>
         typedef sf::priv::GlxContext ContextType;
 
+        #if defined(SFML_EGL_HEADLESS)
+
+            #include <SFML/Window/Unix/EglHeadlessContext.hpp>
+            typedef sf::priv::EglHeadlessContext HeadlessContextType;
+
+        #endif
+
     #elif defined(SFML_SYSTEM_MACOS)
 
         #include <SFML/Window/OSX/SFContext.hpp>
@@ -128,7 +135,7 @@ namespace
     sf::ThreadLocalPtr<sf::priv::GlContext> currentContext(NULL);
 
     // The hidden, inactive context that will be shared with all other contexts
-    ContextType* sharedContext = NULL;
+    sf::priv::GlContext* sharedContext = NULL;
 
     // Internal contexts
     sf::ThreadLocalPtr<sf::priv::GlContext> internalContext(NULL);
@@ -147,6 +154,60 @@ namespace
         return internalContexts.find(internalContext) != internalContexts.end();
     }
 
+#if defined(SFML_EGL_HEADLESS)
+
+    // Check if the contexts must be created without a display server;
+    // the SFML_HEADLESS environment variable forces the choice, otherwise
+    // headless contexts are used when there's no X display to connect to
+    bool isHeadless()
+    {
+        static int headless = -1;
+        if (headless < 0)
+        {
+            const char* variable = std::getenv("SFML_HEADLESS");
+            const char* display = std::getenv("DISPLAY");
+            if (variable && *variable)
+                headless = std::strcmp(variable, "0") != 0;
+            else
+                headless = !display || !*display;
+        }
+
+        return headless != 0;
+    }
+
+#endif
+
+    // Create a context of the type selected for this platform
+    sf::priv::GlContext* newContext(sf::priv::GlContext* shared)
+    {
+#if defined(SFML_EGL_HEADLESS)
+        if (isHeadless())
+            return new HeadlessContextType(static_cast<HeadlessContextType*>(shared));
+#endif
+
+        return new ContextType(static_cast<ContextType*>(shared));
+    }
+
+    sf::priv::GlContext* newContext(sf::priv::GlContext* shared, const sf::ContextSettings& settings, const sf::priv::WindowImpl* owner, unsigned int bitsPerPixel)
+    {
+#if defined(SFML_EGL_HEADLESS)
+        if (isHeadless())
+            return new HeadlessContextType(static_cast<HeadlessContextType*>(shared), settings, owner, bitsPerPixel);
+#endif
+
+        return new ContextType(static_cast<ContextType*>(shared), settings, owner, bitsPerPixel);
+    }
+
+    sf::priv::GlContext* newContext(sf::priv::GlContext* shared, const sf::ContextSettings& settings, unsigned int width, unsigned int height)
+    {
+#if defined(SFML_EGL_HEADLESS)
+        if (isHeadless())
+            return new HeadlessContextType(static_cast<HeadlessContextType*>(shared), settings, width, height);
+#endif
+
+        return new ContextType(static_cast<ContextType*>(shared), settings, width, height);
+    }
+
     // Retrieve the internal context for the current thread
     sf::priv::GlContext* getInternalContext()
     {
@@ -172,7 +233,7 @@ void GlContext::globalInit()
     Lock lock(mutex);
 
     // Create the shared context
-    sharedContext = new ContextType(NULL);
+    sharedContext = newContext(NULL);
     sharedContext->initialize();
 
     // This call makes sure that:
@@ -214,7 +275,7 @@ GlContext* GlContext::create()
     Lock lock(mutex);
 
     // Create the context
-    GlContext* context = new ContextType(sharedContext);
+    GlContext* context = newContext(sharedContext);
     context->initialize();
 
     return context;
@@ -230,7 +291,7 @@ GlContext* GlContext::create(const ContextSettings& settings, const WindowImpl*
     Lock lock(mutex);
 
     // Create the context
-    GlContext* context = new ContextType(sharedContext, settings, owner, bitsPerPixel);
+    GlContext* context = newContext(sharedContext, settings, owner, bitsPerPixel);
     context->initialize();
     context->checkSettings(settings);
 
@@ -247,7 +308,7 @@ GlContext* GlContext::create(const ContextSettings& settings, unsigned int width
     Lock lock(mutex);
 
     // Create the context
-    GlContext* context = new ContextType(sharedContext, settings, width, height);
+    GlContext* context = newContext(sharedContext, settings, width, height);
     context->initialize();
     context->checkSettings(settings);
 
@@ -262,6 +323,11 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 
     Lock lock(mutex);
 
+    #if defined(SFML_EGL_HEADLESS)
+        if (isHeadless())
+            return HeadlessContextType::getFunction(name);
+    #endif
+
     return ContextType::getFunction(name);
 
 #else
@@ -332,6 +398,20 @@ bool GlContext::setActive(bool active)
 }
 
 
+////////////////////////////////////////////////////////////
+void GlContext::displayDamage(const int* /*rectangles*/, std::size_t /*count*/)
+{
+    display();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GlContext::getBufferAge()
+{
+    return 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::GlContext()
 {
@@ -32,6 +32,7 @@
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -170,6 +171,34 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void display() = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display the back buffer, hinting which parts of it changed
+    ///
+    /// The rectangles are stored as consecutive (x, y, width, height)
+    /// quadruples, in pixels, with the origin at the bottom-left
+    /// corner. Pixels outside them may not be updated on screen.
+    /// The default implementation ignores the hint and calls display().
+    ///
+    /// \param rectangles Array of 4 * \a count integers
+    /// \param count      Number of rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void displayDamage(const int* rectangles, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the back buffer
+    ///
+    /// The age is the number of frames that were displayed since
+    /// the back buffer contents were rendered: 1 means that it
+    /// holds the previous frame, 2 the frame before, etc.
+    /// The default implementation returns 0, meaning that the
+    /// contents are undefined and the whole frame must be redrawn.
+    ///
+    /// \return Age of the back buffer, 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBufferAge();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable vertical synchronization
     ///
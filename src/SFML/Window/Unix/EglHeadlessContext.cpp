@@ -0,0 +1,432 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Unix/EglHeadlessContext.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+#include <vector>
+
+// Platforms and context attributes of extensions, which older headers may not define
+#if !defined(EGL_PLATFORM_DEVICE_EXT)
+    #define EGL_PLATFORM_DEVICE_EXT 0x313F
+#endif
+
+#if !defined(EGL_PLATFORM_SURFACELESS_MESA)
+    #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+#if !defined(EGL_CONTEXT_MAJOR_VERSION_KHR)
+    #define EGL_CONTEXT_MAJOR_VERSION_KHR 0x3098
+#endif
+
+#if !defined(EGL_CONTEXT_MINOR_VERSION_KHR)
+    #define EGL_CONTEXT_MINOR_VERSION_KHR 0x30FB
+#endif
+
+#if !defined(EGL_CONTEXT_FLAGS_KHR)
+    #define EGL_CONTEXT_FLAGS_KHR 0x30FC
+#endif
+
+#if !defined(EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR)
+    #define EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR 0x30FD
+#endif
+
+#if !defined(EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR)
+    #define EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR 0x00000001
+#endif
+
+#if !defined(EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR)
+    #define EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR 0x00000001
+#endif
+
+#if !defined(EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR)
+    #define EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR 0x00000002
+#endif
+
+
+namespace
+{
+    typedef EGLDisplay (EGLAPIENTRY *GetPlatformDisplayFuncType)(EGLenum, void*, const EGLint*);
+    typedef EGLBoolean (EGLAPIENTRY *QueryDevicesFuncType)(EGLint, void**, EGLint*);
+
+    // Check if an extension is in a space-separated list of extensions
+    bool hasExtension(const char* extensions, const char* name)
+    {
+        if (!extensions)
+            return false;
+
+        std::size_t length = std::strlen(name);
+        for (const char* start = std::strstr(extensions, name); start; start = std::strstr(start + length, name))
+        {
+            if (((start == extensions) || (start[-1] == ' ')) && ((start[length] == ' ') || (start[length] == '\0')))
+                return true;
+        }
+
+        return false;
+    }
+
+    // Get a display which doesn't depend on a display server
+    EGLDisplay getInitializedDisplay()
+    {
+        static bool initialized = false;
+        static EGLDisplay display = EGL_NO_DISPLAY;
+
+        if (!initialized)
+        {
+            initialized = true;
+
+            // Client extensions are only available with EGL 1.5 or EGL_EXT_client_extensions
+            const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+            eglGetError();
+
+            GetPlatformDisplayFuncType getPlatformDisplay = reinterpret_cast<GetPlatformDisplayFuncType>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+            if (getPlatformDisplay)
+            {
+                // Mesa can render without any display server nor device node
+                if (hasExtension(extensions, "EGL_MESA_platform_surfaceless"))
+                    display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+
+                // Other drivers expose their graphics cards as devices
+                if ((display == EGL_NO_DISPLAY) && hasExtension(extensions, "EGL_EXT_platform_device"))
+                {
+                    QueryDevicesFuncType queryDevices = reinterpret_cast<QueryDevicesFuncType>(eglGetProcAddress("eglQueryDevicesEXT"));
+                    void* device = NULL;
+                    EGLint count = 0;
+                    if (queryDevices && queryDevices(1, &device, &count) && (count > 0))
+                        display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, NULL);
+                }
+            }
+
+            // Last resort, let the implementation choose
+            if (display == EGL_NO_DISPLAY)
+                display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+            if ((display == EGL_NO_DISPLAY) || !eglInitialize(display, NULL, NULL))
+            {
+                sf::err() << "Failed to initialize EGL, headless OpenGL contexts are not available" << std::endl;
+                display = EGL_NO_DISPLAY;
+            }
+        }
+
+        return display;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+EglHeadlessContext::EglHeadlessContext(EglHeadlessContext* shared) :
+m_display(EGL_NO_DISPLAY),
+m_context(EGL_NO_CONTEXT),
+m_surface(EGL_NO_SURFACE)
+{
+    // Get the initialized EGL display
+    m_display = getInitializedDisplay();
+
+    // Create the context, without surface if possible
+    createContext(shared, 32, ContextSettings(), 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+EglHeadlessContext::EglHeadlessContext(EglHeadlessContext* shared, const ContextSettings& settings, const WindowImpl*, unsigned int bitsPerPixel) :
+m_display(EGL_NO_DISPLAY),
+m_context(EGL_NO_CONTEXT),
+m_surface(EGL_NO_SURFACE)
+{
+    err() << "Headless OpenGL contexts can't render to windows, the contents of the window will not be displayed" << std::endl;
+
+    // Get the initialized EGL display
+    m_display = getInitializedDisplay();
+
+    // Create the context, without surface if possible
+    createContext(shared, bitsPerPixel, settings, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+EglHeadlessContext::EglHeadlessContext(EglHeadlessContext* shared, const ContextSettings& settings, unsigned int width, unsigned int height) :
+m_display(EGL_NO_DISPLAY),
+m_context(EGL_NO_CONTEXT),
+m_surface(EGL_NO_SURFACE)
+{
+    // Get the initialized EGL display
+    m_display = getInitializedDisplay();
+
+    // Create the context, with a back buffer of the requested size
+    createContext(shared, 32, settings, width, height);
+}
+
+
+////////////////////////////////////////////////////////////
+EglHeadlessContext::~EglHeadlessContext()
+{
+    // Deactivate the context if it's the current one
+    if ((m_context != EGL_NO_CONTEXT) && (eglGetCurrentContext() == m_context))
+    {
+        eglCheck(eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
+    }
+
+    // Destroy the context
+    if (m_context != EGL_NO_CONTEXT)
+    {
+        eglCheck(eglDestroyContext(m_display, m_context));
+    }
+
+    // Destroy the surface
+    if (m_surface != EGL_NO_SURFACE)
+    {
+        eglCheck(eglDestroySurface(m_display, m_surface));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+GlFunctionPointer EglHeadlessContext::getFunction(const char* name)
+{
+    return reinterpret_cast<GlFunctionPointer>(eglGetProcAddress(name));
+}
+
+
+////////////////////////////////////////////////////////////
+bool EglHeadlessContext::makeCurrent()
+{
+    if (m_context == EGL_NO_CONTEXT)
+        return false;
+
+    // The current API is a per-thread state
+    eglCheck(eglBindAPI(EGL_OPENGL_API));
+
+    EGLBoolean result = eglCheck(eglMakeCurrent(m_display, m_surface, m_surface, m_context));
+
+    return result == EGL_TRUE;
+}
+
+
+////////////////////////////////////////////////////////////
+void EglHeadlessContext::display()
+{
+    // Nothing to do
+}
+
+
+////////////////////////////////////////////////////////////
+void EglHeadlessContext::setVerticalSyncEnabled(bool)
+{
+    // Nothing to do
+}
+
+
+////////////////////////////////////////////////////////////
+void EglHeadlessContext::createContext(EglHeadlessContext* shared, unsigned int bitsPerPixel, const ContextSettings& settings, unsigned int width, unsigned int height)
+{
+    // Save the creation settings
+    m_settings = settings;
+
+    if (m_display == EGL_NO_DISPLAY)
+        return;
+
+    const char* extensions = eglQueryString(m_display, EGL_EXTENSIONS);
+    bool hasSurfaceless = hasExtension(extensions, "EGL_KHR_surfaceless_context");
+
+    // Prefer a config which supports pixel buffers, so that we can create a surface if needed
+    bool hasPbuffer = true;
+    EGLConfig config = selectBestConfig(bitsPerPixel, settings, true);
+    if (!config && hasSurfaceless)
+    {
+        hasPbuffer = false;
+        config = selectBestConfig(bitsPerPixel, settings, false);
+    }
+
+    if (!config)
+    {
+        err() << "Failed to find an EGL config for the headless OpenGL context" << std::endl;
+        return;
+    }
+
+    // Create the surface, unless the context can do without it
+    if (hasPbuffer && (!hasSurfaceless || (width && height)))
+    {
+        EGLint attributes[] =
+        {
+            EGL_WIDTH,  static_cast<EGLint>(width  ? width  : 1),
+            EGL_HEIGHT, static_cast<EGLint>(height ? height : 1),
+            EGL_NONE
+        };
+
+        m_surface = eglCheck(eglCreatePbufferSurface(m_display, config, attributes));
+
+        if ((m_surface == EGL_NO_SURFACE) && !hasSurfaceless)
+        {
+            err() << "Failed to create the surface of the headless OpenGL context" << std::endl;
+            return;
+        }
+    }
+
+    // Get the context to share display lists with
+    EGLContext toShare = shared ? shared->m_context : EGL_NO_CONTEXT;
+
+    // Contexts are created for the current API, which is a per-thread state
+    eglCheck(eglBindAPI(EGL_OPENGL_API));
+
+    // Check if we need to use EGL_KHR_create_context
+    bool hasCreateContextKhr = hasExtension(extensions, "EGL_KHR_create_context");
+    bool needCreateContextKhr = m_settings.attributeFlags || (m_settings.majorVersion >= 3);
+
+    // Create the OpenGL context -- first try with the requested version and profile if we need to
+    while (hasCreateContextKhr && needCreateContextKhr && (m_context == EGL_NO_CONTEXT) && m_settings.majorVersion)
+    {
+        EGLint profile = (m_settings.attributeFlags & ContextSettings::Core) ? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR;
+        EGLint debug = (m_settings.attributeFlags & ContextSettings::Debug) ? EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR : 0;
+
+        EGLint attributes[] =
+        {
+            EGL_CONTEXT_MAJOR_VERSION_KHR,       static_cast<EGLint>(m_settings.majorVersion),
+            EGL_CONTEXT_MINOR_VERSION_KHR,       static_cast<EGLint>(m_settings.minorVersion),
+            EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, profile,
+            EGL_CONTEXT_FLAGS_KHR,               debug,
+            EGL_NONE
+        };
+
+        // We simply ignore errors here, the context is null anyway
+        m_context = eglCreateContext(m_display, config, toShare, attributes);
+        eglGetError();
+
+        if (m_context == EGL_NO_CONTEXT)
+        {
+            // If we couldn't create the context, first try disabling flags,
+            // then lower the version number and try again -- stop at 0.0
+            if (m_settings.attributeFlags != ContextSettings::Default)
+            {
+                m_settings.attributeFlags = ContextSettings::Default;
+            }
+            else if (m_settings.minorVersion > 0)
+            {
+                // If the minor version is not 0, we decrease it and try again
+                m_settings.minorVersion--;
+
+                m_settings.attributeFlags = settings.attributeFlags;
+            }
+            else
+            {
+                // If the minor version is 0, we decrease the major version
+                m_settings.majorVersion--;
+                m_settings.minorVersion = 9;
+
+                m_settings.attributeFlags = settings.attributeFlags;
+            }
+        }
+    }
+
+    // If the versioned creation failed, let the implementation choose the version
+    if (m_context == EGL_NO_CONTEXT)
+    {
+        // set the context version to 2.1 (arbitrary) and disable flags
+        m_settings.majorVersion = 2;
+        m_settings.minorVersion = 1;
+        m_settings.attributeFlags = ContextSettings::Default;
+
+        m_context = eglCheck(eglCreateContext(m_display, config, toShare, NULL));
+    }
+
+    if (m_context == EGL_NO_CONTEXT)
+    {
+        err() << "Failed to create a headless OpenGL context" << std::endl;
+    }
+    else
+    {
+        // Update the creation settings from the chosen config
+        EGLint depth, stencil, multiSampling, samples;
+        eglCheck(eglGetConfigAttrib(m_display, config, EGL_DEPTH_SIZE,     &depth));
+        eglCheck(eglGetConfigAttrib(m_display, config, EGL_STENCIL_SIZE,   &stencil));
+        eglCheck(eglGetConfigAttrib(m_display, config, EGL_SAMPLE_BUFFERS, &multiSampling));
+        eglCheck(eglGetConfigAttrib(m_display, config, EGL_SAMPLES,        &samples));
+
+        m_settings.depthBits         = static_cast<unsigned int>(depth);
+        m_settings.stencilBits       = static_cast<unsigned int>(stencil);
+        m_settings.antialiasingLevel = multiSampling ? samples : 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+EGLConfig EglHeadlessContext::selectBestConfig(unsigned int bitsPerPixel, const ContextSettings& settings, bool pbuffer)
+{
+    // Retrieve all the configs suitable for desktop OpenGL
+    const EGLint attributes[] =
+    {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_SURFACE_TYPE,    pbuffer ? EGL_PBUFFER_BIT : 0,
+        EGL_NONE
+    };
+
+    EGLint count = 0;
+    if (!eglChooseConfig(m_display, attributes, NULL, 0, &count) || (count == 0))
+        return NULL;
+
+    std::vector<EGLConfig> configs(count);
+    eglCheck(eglChooseConfig(m_display, attributes, &configs[0], count, &count));
+
+    // Evaluate all the returned configs, and pick the best one
+    int bestScore = 0x7FFFFFFF;
+    EGLConfig bestConfig = NULL;
+    for (EGLint i = 0; i < count; ++i)
+    {
+        // Extract the components of the current config
+        EGLint red, green, blue, alpha, depth, stencil, multiSampling, samples, caveat;
+        eglCheck(eglGetConfigAttrib(m_display, configs[i], EGL_RED_SIZE,       &red));
+        eglCheck(eglGetConfigAttrib(m_display, configs[i], EGL_GREEN_SIZE,     &green));
+        eglCheck(eglGetConfigAttrib(m_display, configs[i], EGL_BLUE_SIZE,      &blue));
+        eglCheck(eglGetConfigAttrib(m_display, configs[i], EGL_ALPHA_SIZE,     &alpha));
+        eglCheck(eglGetConfigAttrib(m_display, configs[i], EGL_DEPTH_SIZE,     &depth));
+        eglCheck(eglGetConfigAttrib(m_display, configs[i], EGL_STENCIL_SIZE,   &stencil));
+        eglCheck(eglGetConfigAttrib(m_display, configs[i], EGL_SAMPLE_BUFFERS, &multiSampling));
+        eglCheck(eglGetConfigAttrib(m_display, configs[i], EGL_SAMPLES,        &samples));
+        eglCheck(eglGetConfigAttrib(m_display, configs[i], EGL_CONFIG_CAVEAT,  &caveat));
+
+        // Evaluate the config
+        int color = red + green + blue + alpha;
+        int score = evaluateFormat(bitsPerPixel, settings, color, depth, stencil, multiSampling ? samples : 0, caveat != EGL_SLOW_CONFIG);
+
+        // If it's better than the current best, make it the new best
+        if (score < bestScore)
+        {
+            bestScore = score;
+            bestConfig = configs[i];
+        }
+    }
+
+    return bestConfig;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_EGLHEADLESSCONTEXT_HPP
+#define SFML_EGLHEADLESSCONTEXT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/GlContext.hpp>
+#include <SFML/Window/EGLCheck.hpp>
+#include <EGL/egl.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Linux (EGL) implementation of OpenGL contexts
+///        which don't need a display server
+///
+////////////////////////////////////////////////////////////
+class EglHeadlessContext : public GlContext
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new default context
+    ///
+    /// \param shared Context to share the new one with (can be NULL)
+    ///
+    ////////////////////////////////////////////////////////////
+    EglHeadlessContext(EglHeadlessContext* shared);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new context attached to a window
+    ///
+    /// Headless contexts can't render to windows: the context
+    /// is created, but what is drawn is never shown.
+    ///
+    /// \param shared       Context to share the new one with
+    /// \param settings     Creation parameters
+    /// \param owner        Pointer to the owner window
+    /// \param bitsPerPixel Pixel depth, in bits per pixel
+    ///
+    ////////////////////////////////////////////////////////////
+    EglHeadlessContext(EglHeadlessContext* shared, const ContextSettings& settings, const WindowImpl* owner, unsigned int bitsPerPixel);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new context that embeds its own rendering target
+    ///
+    /// \param shared   Context to share the new one with
+    /// \param settings Creation parameters
+    /// \param width    Back buffer width, in pixels
+    /// \param height   Back buffer height, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    EglHeadlessContext(EglHeadlessContext* shared, const ContextSettings& settings, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~EglHeadlessContext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of an OpenGL function
+    ///
+    /// \param name Name of the function to get the address of
+    ///
+    /// \return Address of the OpenGL function, 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static GlFunctionPointer getFunction(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the context as the current target for rendering
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool makeCurrent();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Display what has been rendered to the context so far
+    ///
+    /// There's nothing to display to, so this function does nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void display();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable vertical synchronization
+    ///
+    /// There's no monitor to synchronize with, so this function
+    /// does nothing.
+    ///
+    /// \param enabled True to enable v-sync, false to deactivate
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setVerticalSyncEnabled(bool enabled);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the context and its surface
+    ///
+    /// \param shared       Context to share the new one with (can be NULL)
+    /// \param bitsPerPixel Pixel depth, in bits per pixel
+    /// \param settings     Creation parameters
+    /// \param width        Width of the surface, or 0 to have no surface if possible
+    /// \param height       Height of the surface, or 0 to have no surface if possible
+    ///
+    ////////////////////////////////////////////////////////////
+    void createContext(EglHeadlessContext* shared, unsigned int bitsPerPixel, const ContextSettings& settings, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the best EGL config for a given set of settings
+    ///
+    /// \param bitsPerPixel Pixel depth, in bits per pixel
+    /// \param settings     Requested context settings
+    /// \param pbuffer      Must the config support pixel buffer surfaces?
+    ///
+    /// \return The best config, or NULL if none was found
+    ///
+    ////////////////////////////////////////////////////////////
+    EGLConfig selectBestConfig(unsigned int bitsPerPixel, const ContextSettings& settings, bool pbuffer);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    EGLDisplay m_display; ///< EGL display, not connected to any display server
+    EGLContext m_context; ///< OpenGL context
+    EGLSurface m_surface; ///< Pixel buffer surface, or EGL_NO_SURFACE for surfaceless contexts
+};
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_EGLHEADLESSCONTEXT_HPP
@@ -270,6 +270,22 @@ void GlxContext::display()
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int GlxContext::getBufferAge()
+{
+    // Make sure that extensions are initialized
+    ensureExtensionsInit(m_display, DefaultScreen(m_display));
+
+    if (!m_window || (sfglx_ext_EXT_buffer_age != sfglx_LOAD_SUCCEEDED))
+        return 0;
+
+    unsigned int age = 0;
+    glXQueryDrawable(m_display, m_window, GLX_BACK_BUFFER_AGE_EXT, &age);
+
+    return age;
+}
+
+
 ////////////////////////////////////////////////////////////
 void GlxContext::setVerticalSyncEnabled(bool enabled)
 {
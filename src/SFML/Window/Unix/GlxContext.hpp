@@ -105,6 +105,18 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void display();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the back buffer
+    ///
+    /// GLX has no swap-with-damage extension, so displayDamage
+    /// keeps swapping the whole buffer; the buffer age is still
+    /// enough to let the caller redraw only what changed.
+    ///
+    /// \return Age of the back buffer, 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBufferAge();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable vertical synchronization
     ///
@@ -147,6 +147,7 @@ extern int sfglx_ext_SGI_swap_control;
 extern int sfglx_ext_ARB_multisample;
 extern int sfglx_ext_ARB_create_context;
 extern int sfglx_ext_ARB_create_context_profile;
+extern int sfglx_ext_EXT_buffer_age;
 
 #define GLX_MAX_SWAP_INTERVAL_EXT 0x20F2
 #define GLX_SWAP_INTERVAL_EXT 0x20F1
@@ -164,6 +165,8 @@ extern int sfglx_ext_ARB_create_context_profile;
 #define GLX_CONTEXT_CORE_PROFILE_BIT_ARB 0x00000001
 #define GLX_CONTEXT_PROFILE_MASK_ARB 0x9126
 
+#define GLX_BACK_BUFFER_AGE_EXT 0x20F4
+
 #ifndef GLX_EXT_swap_control
 #define GLX_EXT_swap_control 1
 extern void (CODEGEN_FUNCPTR *sf_ptrc_glXSwapIntervalEXT)(Display *, GLXDrawable, int);
@@ -355,9 +355,8 @@ bool Window::hasFocus() const
 
 void Window::display()
 {
-    // Display the backbuffer on screen
-    if (setActive())
-        m_context->display();
+    // Display the backbuffer on screen (derived classes may present only parts of it)
+    onDisplay();
 
     // Limit the framerate if needed
     if (m_frameTimeLimit != Time::Zero)
@@ -368,6 +367,22 @@ void Window::display()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::displayDamage(const int* rectangles, std::size_t count)
+{
+    // Present only the parts of the backbuffer that changed, if any
+    if ((count > 0) && setActive())
+        m_context->displayDamage(rectangles, count);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Window::getBufferAge() const
+{
+    return setActive() ? m_context->getBufferAge() : 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 WindowHandle Window::getSystemHandle() const
 {
@@ -389,6 +404,15 @@ void Window::onResize()
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::onDisplay()
+{
+    // Display the whole backbuffer on screen
+    if (setActive())
+        m_context->display();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::filterEvent(const Event& event)
 {